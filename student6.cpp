@@ -7,28 +7,71 @@
 #include <iomanip>
 #include <sstream>
 #include <map>
+#include <set>
+#include <unordered_map>
 #include <functional>
 #include <cctype>
-#include <conio.h>
+#include <climits>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+#include <charconv>
+#include <filesystem>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <chrono>
+#include <unordered_set>
+#include <random>
+#include <cmath>
+#include <new>
+#include <memory>
+#include <cstdlib>
+#include <cerrno>
 
 #ifdef _WIN32
+#include <conio.h>
 #include <windows.h>
+#include <psapi.h>
+#include <io.h>
+#include <fcntl.h>
+#include <sys/stat.h>
 #else
 #include <unistd.h>
+#include <termios.h>
+#include <sys/ioctl.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/resource.h>
+#endif
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#elif defined(_MSC_VER)
+#include <intrin.h>
 #endif
 
 using namespace std;
 
 // Constants
 const string STUDENT_FILE = "students.txt";
+const string STUDENT_LOG_FILE = "students.log";
 const string ATTENDANCE_FILE = "attendance.txt";
+const string LEGACY_ATTENDANCE_STORE_FILE = "attendance.dat";
+const string ATTENDANCE_SEGMENT_DIR = "attendance";
+const string ATTENDANCE_MANIFEST_FILE = "attendance/manifest.txt";
+const string ATTENDANCE_COUNTERS_FILE = "attendance/counters.dat";
+const string ATTENDANCE_COUNTER_DELTAS_FILE = "attendance/counters.log";
 const string ADMIN_FILE = "admin.txt";
 const string TEACHER_FILE = "teacher.txt";
 const string STUDENT_CREDENTIALS_FILE = "student_credentials.txt";
+const string STUDENT_ACCOUNTS_FILE = "student_accounts.txt";
 const string EXAM_RESULTS_FILE = "exam_results.txt";
+const string WARM_START_FILE = "warmstart.dat";
 
-// Color codes for console
-#ifdef _WIN32
+// Color codes for console (Windows console attributes; mapped to ANSI colors by Screen)
 const int COLOR_DEFAULT = 7;
 const int COLOR_GREEN = 10;
 const int COLOR_RED = 12;
@@ -36,15 +79,6 @@ const int COLOR_YELLOW = 14;
 const int COLOR_CYAN = 11;
 const int COLOR_BLUE = 9;
 const int COLOR_MAGENTA = 13;
-#else
-const string COLOR_DEFAULT = "\033[0m";
-const string COLOR_GREEN = "\033[32m";
-const string COLOR_RED = "\033[31m";
-const string COLOR_YELLOW = "\033[33m";
-const string COLOR_CYAN = "\033[36m";
-const string COLOR_BLUE = "\033[34m";
-const string COLOR_MAGENTA = "\033[35m";
-#endif
 
 // Forward declarations
 class Student;
@@ -54,35 +88,669 @@ class Admin;
 class User;
 class StudentUser;
 
-// Utility functions
-void gotoxy(int x, int y) {
-#ifdef _WIN32
-    COORD coord;
-    coord.X = x;
-    coord.Y = y;
-    SetConsoleCursorPosition(GetStdHandle(STD_OUTPUT_HANDLE), coord);
+// Performance Counters
+// Hot-path tallies - files opened, bytes read, records parsed, records matched, heap
+// allocations and time spent waiting for the user. Each thread bumps its own slot, so
+// a bump is a plain relaxed increment with no sharing; the slots are only summed when
+// a PerfScope starts or ends. Past 64 concurrent threads the extra threads share the
+// last slot and its counts become approximate.
+class PerfCounters {
+public:
+    enum Kind { FILES_OPENED, BYTES_READ, RECORDS_PARSED, RECORDS_MATCHED, ALLOCATIONS, INPUT_WAIT_US, KINDS };
+
+    struct Totals {
+        uint64_t values[KINDS] = {};
+
+        Totals operator-(const Totals& earlier) const {
+            Totals delta;
+            for (int k = 0; k < KINDS; k++) delta.values[k] = values[k] - earlier.values[k];
+            return delta;
+        }
+    };
+
+private:
+    static const int MAX_SLOTS = 64;
+
+    struct alignas(64) Slot {
+        atomic<uint64_t> values[KINDS];
+    };
+
+    static Slot* slots() {
+        static Slot storage[MAX_SLOTS];
+        return storage;
+    }
+
+    static atomic<uint64_t>& claimedMask() {
+        static atomic<uint64_t> mask(0);
+        return mask;
+    }
+
+    static atomic<int>& slotsSeen() {
+        static atomic<int> seen(0);
+        return seen;
+    }
+
+    // A thread keeps its slot until it exits; what it counted stays in the totals
+    struct Claim {
+        int index;
+
+        Claim() : index(MAX_SLOTS - 1) {
+            uint64_t mask = claimedMask().load();
+            for (int i = 0; i < MAX_SLOTS - 1; i++) {
+                uint64_t bit = uint64_t(1) << i;
+                while (!(mask & bit)) {
+                    if (claimedMask().compare_exchange_weak(mask, mask | bit)) {
+                        index = i;
+                        i = MAX_SLOTS;
+                        break;
+                    }
+                }
+            }
+            int seen = slotsSeen().load();
+            while (seen <= index && !slotsSeen().compare_exchange_weak(seen, index + 1)) {}
+        }
+
+        ~Claim() {
+            if (index < MAX_SLOTS - 1) claimedMask().fetch_and(~(uint64_t(1) << index));
+        }
+    };
+
+    static Slot& mine() {
+        thread_local Claim claim;
+        return slots()[claim.index];
+    }
+
+public:
+    static void add(Kind kind, uint64_t amount = 1) {
+        atomic<uint64_t>& value = mine().values[kind];
+        value.store(value.load(memory_order_relaxed) + amount, memory_order_relaxed);
+    }
+
+    // Charges the time since a blocking read started as time spent waiting for the user
+    static void addInputWait(chrono::steady_clock::time_point since) {
+        auto waited = chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - since);
+        add(INPUT_WAIT_US, static_cast<uint64_t>(waited.count()));
+    }
+
+    // Sum over every thread that has counted anything so far
+    static Totals read() {
+        Totals totals;
+        int seen = slotsSeen().load();
+        for (int s = 0; s < seen; s++) {
+            for (int k = 0; k < KINDS; k++) totals.values[k] += slots()[s].values[k].load(memory_order_relaxed);
+        }
+        return totals;
+    }
+};
+
+// Global allocation functions, counted for PerfCounters. The deletes stay out of line so
+// GCC does not pair a new-expression with the free() inside them and warn.
+#if defined(__GNUC__)
+#define PERF_OUT_OF_LINE __attribute__((noinline))
 #else
-    printf("\033[%d;%dH", y + 1, x + 1);
+#define PERF_OUT_OF_LINE
 #endif
+
+void* operator new(size_t size) {
+    PerfCounters::add(PerfCounters::ALLOCATIONS);
+    if (void* block = malloc(size ? size : 1)) return block;
+    throw bad_alloc();
 }
 
-void setColor(int color) {
+PERF_OUT_OF_LINE void operator delete(void* block) noexcept {
+    free(block);
+}
+
+PERF_OUT_OF_LINE void operator delete(void* block, size_t) noexcept {
+    free(block);
+}
+
+// Performance Stats Class
+// Per-operation totals filed by PerfScope: calls, total and worst elapsed time and the
+// counter deltas. Read by the admin Performance Stats panel.
+class PerfStats {
+public:
+    struct Entry {
+        uint64_t calls = 0;
+        double totalMs = 0.0;
+        double maxMs = 0.0;
+        PerfCounters::Totals counters;
+    };
+
+private:
+    mutex lock;
+    unordered_map<string, Entry> entries;
+    unordered_map<const char*, Entry*> byLiteral;   // scopes named by a string literal skip the hashing
+
+    static PerfStats& instance() {
+        static PerfStats stats;
+        return stats;
+    }
+
+    Entry& entryFor(const char* literal, const string& operation) {
+        if (!literal) return entries[operation];
+        Entry*& cached = byLiteral[literal];
+        if (!cached) cached = &entries[literal];
+        return *cached;
+    }
+
+public:
+    // literal, when given, names the operation and must outlive the program (a string literal)
+    static void record(const char* literal, const string& operation, double ms, const PerfCounters::Totals& delta) {
+        PerfStats& stats = instance();
+        lock_guard<mutex> guard(stats.lock);
+        Entry& entry = stats.entryFor(literal, operation);
+        entry.calls++;
+        entry.totalMs += ms;
+        entry.maxMs = max(entry.maxMs, ms);
+        for (int k = 0; k < PerfCounters::KINDS; k++) entry.counters.values[k] += delta.values[k];
+    }
+
+    // Every operation seen so far, the most expensive (by total time) first
+    static vector<pair<string, Entry>> snapshot() {
+        PerfStats& stats = instance();
+        vector<pair<string, Entry>> result;
+        {
+            lock_guard<mutex> guard(stats.lock);
+            result.assign(stats.entries.begin(), stats.entries.end());
+        }
+        sort(result.begin(), result.end(), [](const pair<string, Entry>& a, const pair<string, Entry>& b) {
+            return a.second.totalMs > b.second.totalMs;
+        });
+        return result;
+    }
+
+    static void reset() {
+        PerfStats& stats = instance();
+        lock_guard<mutex> guard(stats.lock);
+        stats.byLiteral.clear();
+        stats.entries.clear();
+    }
+
+    static bool dump(const string& filename) {
+        ofstream file(filename);
+        if (!file) return false;
+
+        file << "Operation,Calls,Total ms,Average ms,Max ms,Files Opened,Bytes Read,Records Parsed,"
+             << "Records Matched,Allocations\n";
+        file << fixed << setprecision(3);
+        for (const auto& item : snapshot()) {
+            const Entry& entry = item.second;
+            file << "\"" << item.first << "\"," << entry.calls << "," << entry.totalMs << ","
+                 << entry.totalMs / entry.calls << "," << entry.maxMs;
+            for (int k = 0; k < PerfCounters::INPUT_WAIT_US; k++) file << "," << entry.counters.values[k];
+            file << "\n";
+        }
+        file.close();
+        return true;
+    }
+};
+
+// Perf Scope Class
+// Times one named operation and files its counter deltas with PerfStats when it ends.
+// Scopes nest, each recording inclusive figures. Time spent waiting at a prompt is
+// left out of the elapsed time.
+class PerfScope {
+private:
+    const char* literal;
+    string operation;
+    PerfCounters::Totals start;
+    chrono::steady_clock::time_point started;
+
+public:
+    explicit PerfScope(const char* name)
+        : literal(name), start(PerfCounters::read()), started(chrono::steady_clock::now()) {}
+
+    explicit PerfScope(string name)
+        : literal(nullptr), operation(move(name)), start(PerfCounters::read()), started(chrono::steady_clock::now()) {}
+
+    ~PerfScope() {
+        double ms = chrono::duration<double, milli>(chrono::steady_clock::now() - started).count();
+        PerfCounters::Totals delta = PerfCounters::read() - start;
+        ms = max(0.0, ms - delta.values[PerfCounters::INPUT_WAIT_US] / 1000.0);
+        PerfStats::record(literal, operation, ms, delta);
+    }
+
+    PerfScope(const PerfScope&) = delete;
+    PerfScope& operator=(const PerfScope&) = delete;
+};
+
+// Screen Class
+// The UI draws into an in-memory frame (a character and a color per cell) instead of
+// the console: cout is redirected into the frame, and gotoxy/setColor only move the
+// frame's cursor and change its pen. present() compares the frame with what the
+// terminal already shows and sends just the changed cells - cursor moves, color
+// changes and text - in one write. It runs whenever the program is about to wait:
+// before reading a key, when cin flushes cout ahead of line input, and before sleeping.
+// Each frame's byte and write-call counts are kept for the statistics screen.
+class Screen {
+public:
+    struct FrameStats {
+        size_t frames = 0;
+        size_t bytes = 0;
+        size_t writes = 0;          // output calls, including retries after partial writes
+        size_t cells = 0;           // cells that changed
+        size_t lastBytes = 0;
+        size_t lastWrites = 0;
+        size_t lastCells = 0;
+        size_t largestBytes = 0;
+    };
+
+private:
+    static constexpr int WIDTH = 80;
+
+    struct Cell {
+        char ch;
+        int color;
+
+        bool operator==(const Cell& other) const { return ch == other.ch && color == other.color; }
+        bool operator!=(const Cell& other) const { return !(*this == other); }
+    };
+
+    class FrameBuffer : public streambuf {
+    protected:
+        int overflow(int c) override {
+            if (c != EOF) Screen::put(static_cast<char>(c));
+            return c;
+        }
+
+        streamsize xsputn(const char* text, streamsize count) override {
+            for (streamsize i = 0; i < count; i++) Screen::put(text[i]);
+            return count;
+        }
+
+        // cin flushes cout before every read, so a sync means line input may follow
+        int sync() override {
+            Screen::present(true);
+            return 0;
+        }
+    };
+
+    // Hands cin the real input one character at a time, timing the reads that block so
+    // prompts are not counted as work by PerfScope
+    class InputBuffer : public streambuf {
+    public:
+        streambuf* source = nullptr;
+
+    protected:
+        int_type underflow() override {
+            auto started = chrono::steady_clock::now();
+            int_type c = source->sgetc();
+            PerfCounters::addInputWait(started);
+            return c;
+        }
+
+        int_type uflow() override {
+            int_type c = underflow();
+            if (!traits_type::eq_int_type(c, traits_type::eof())) source->sbumpc();
+            return c;
+        }
+
+        int_type pbackfail(int_type c) override {
+            if (traits_type::eq_int_type(c, traits_type::eof())) return source->sungetc();
+            return source->sputbackc(traits_type::to_char_type(c));
+        }
+    };
+
+    vector<vector<Cell>> frame;     // what is being drawn
+    vector<vector<Cell>> shown;     // what the terminal currently shows
+    int cursorX, cursorY, pen;
+    int echoRow;                    // row the terminal may have echoed typed input on
+    int terminalX, terminalY;       // where the terminal's own cursor is (-1 when unknown)
+    int terminalColor;
+    bool installed, cleared;
+    FrameStats stats;
+    FrameBuffer buffer;
+    InputBuffer input;
+    streambuf* original;
+#ifdef _WIN32
+    bool virtualTerminal;
+#endif
+
+    Screen() : cursorX(0), cursorY(0), pen(COLOR_DEFAULT), echoRow(-1), terminalX(-1),
+               terminalY(-1), terminalColor(-1), installed(false), cleared(false),
+               original(nullptr) {
+#ifdef _WIN32
+        virtualTerminal = false;
+#endif
+    }
+
+    static Screen& instance() {
+        static Screen screen;
+        return screen;
+    }
+
+    static Cell blank() {
+        return {' ', COLOR_DEFAULT};
+    }
+
+    void ensureRow(int y) {
+        while (static_cast<int>(frame.size()) <= y) frame.emplace_back(WIDTH, blank());
+        while (static_cast<int>(shown.size()) <= y) shown.emplace_back(WIDTH, blank());
+    }
+
+    static void put(char c) {
+        Screen& screen = instance();
+        switch (c) {
+            case '\n': screen.cursorX = 0; screen.cursorY++; return;
+            case '\r': screen.cursorX = 0; return;
+            case '\b': if (screen.cursorX > 0) screen.cursorX--; return;
+        }
+
+        if (screen.cursorX >= WIDTH) {
+            screen.cursorX = 0;
+            screen.cursorY++;
+        }
+        screen.ensureRow(screen.cursorY);
+        screen.frame[screen.cursorY][screen.cursorX++] = {c, screen.pen};
+    }
+
+    static const char* ansiColor(int color) {
+        switch (color) {
+            case COLOR_GREEN: return "\033[0;32m";
+            case COLOR_RED: return "\033[0;31m";
+            case COLOR_YELLOW: return "\033[0;33m";
+            case COLOR_CYAN: return "\033[0;36m";
+            case COLOR_BLUE: return "\033[0;34m";
+            case COLOR_MAGENTA: return "\033[0;35m";
+            default: return "\033[0m";
+        }
+    }
+
+    // The box-drawing characters are code page 437; UTF-8 terminals need them re-encoded
+    static void appendGlyph(string& out, char c) {
+#ifdef _WIN32
+        out += c;
+#else
+        switch (static_cast<unsigned char>(c)) {
+            case 218: out += "┌"; break;
+            case 191: out += "┐"; break;
+            case 192: out += "└"; break;
+            case 217: out += "┘"; break;
+            case 196: out += "─"; break;
+            case 179: out += "│"; break;
+            default: out += c; break;
+        }
+#endif
+    }
+
+    // Rows in use: everything up to the last non-blank cell or the cursor
+    int usedRows() const {
+        int used = cursorY + 1;
+        for (int y = static_cast<int>(frame.size()) - 1; y >= used; y--) {
+            for (const Cell& cell : frame[y]) {
+                if (cell.ch != ' ') return y + 1;
+            }
+        }
+        return used;
+    }
+
+    int rowLength(int y) const {
+        int length = WIDTH;
+        while (length > 0 && frame[y][length - 1].ch == ' ') length--;
+        return y == cursorY ? max(length, cursorX) : length;
+    }
+
+    static int terminalRows() {
+#ifdef _WIN32
+        CONSOLE_SCREEN_BUFFER_INFO info;
+        if (GetConsoleScreenBufferInfo(GetStdHandle(STD_OUTPUT_HANDLE), &info)) {
+            return info.srWindow.Bottom - info.srWindow.Top + 1;
+        }
+#else
+        winsize size;
+        if (ioctl(STDOUT_FILENO, TIOCGWINSZ, &size) == 0 && size.ws_row > 0) return size.ws_row;
+#endif
+        return 30;
+    }
+
+    static void appendMove(string& out, int x, int y) {
+        out += "\033[" + to_string(y + 1) + ";" + to_string(x + 1) + "H";
+    }
+
+    // Writes the whole buffer, retrying after partial writes; returns the calls made
+    static size_t writeOut(const string& out) {
+        size_t done = 0, calls = 0;
+        while (done < out.size()) {
+            calls++;
 #ifdef _WIN32
-    SetConsoleTextAttribute(GetStdHandle(STD_OUTPUT_HANDLE), color);
+            DWORD written = 0;
+            if (!WriteConsoleA(GetStdHandle(STD_OUTPUT_HANDLE), out.data() + done,
+                               static_cast<DWORD>(out.size() - done), &written, nullptr) || written == 0) break;
 #else
-    switch (color) {
-        case COLOR_GREEN: cout << COLOR_GREEN; break;
-        case COLOR_RED: cout << COLOR_RED; break;
-        case COLOR_YELLOW: cout << COLOR_YELLOW; break;
-        case COLOR_CYAN: cout << COLOR_CYAN; break;
-        case COLOR_BLUE: cout << COLOR_BLUE; break;
-        case COLOR_MAGENTA: cout << COLOR_MAGENTA; break;
-        default: cout << COLOR_DEFAULT; break;
+            ssize_t written = ::write(STDOUT_FILENO, out.data() + done, out.size() - done);
+            if (written <= 0) break;
+#endif
+            done += written;
+        }
+        return calls;
+    }
+
+    void record(size_t bytes, size_t writes, size_t cells) {
+        stats.frames++;
+        stats.bytes += bytes;
+        stats.writes += writes;
+        stats.cells += cells;
+        stats.lastBytes = bytes;
+        stats.lastWrites = writes;
+        stats.lastCells = cells;
+        stats.largestBytes = max(stats.largestBytes, bytes);
+    }
+
+    // A frame taller than the terminal (long lists and tables) cannot be addressed by
+    // row, so it is printed top to bottom and left to scroll; the next frame repaints.
+    void presentScrolling(int used) {
+        string out = "\033[0m\033[2J\033[H";
+        int color = COLOR_DEFAULT;
+        size_t cells = 0;
+        for (int y = 0; y < used; y++) {
+            int length = rowLength(y);
+            cells += length;
+            for (int x = 0; x < length; x++) {
+                if (frame[y][x].color != color) {
+                    out += ansiColor(frame[y][x].color);
+                    color = frame[y][x].color;
+                }
+                appendGlyph(out, frame[y][x].ch);
+            }
+            if (y + 1 < used) out += "\r\n";
+        }
+
+        if (cursorY < used - 1) out += "\033[" + to_string(used - 1 - cursorY) + "A";
+        out += "\r";
+        if (cursorX > 0) out += "\033[" + to_string(cursorX) + "C";
+        if (color != pen) out += ansiColor(pen);
+        record(out.size(), writeOut(out), cells);
+
+        for (auto& row : shown) fill(row.begin(), row.end(), blank());
+        cleared = false;
+        echoRow = -1;
+        terminalX = -1;
+    }
+
+#ifdef _WIN32
+    // Consoles without escape-sequence support get the changed runs through the console API
+    void presentLegacy() {
+        HANDLE console = GetStdHandle(STD_OUTPUT_HANDLE);
+        size_t bytes = 0, calls = 0, cells = 0;
+        for (int y = 0; y < static_cast<int>(frame.size()); y++) {
+            for (int x = 0; x < WIDTH; ) {
+                if (frame[y][x] == shown[y][x]) {
+                    x++;
+                    continue;
+                }
+                int color = frame[y][x].color;
+                string run;
+                int start = x;
+                while (x < WIDTH && frame[y][x] != shown[y][x] && frame[y][x].color == color) {
+                    run += frame[y][x].ch;
+                    shown[y][x] = frame[y][x];
+                    x++;
+                }
+                COORD coord;
+                coord.X = start;
+                coord.Y = y;
+                SetConsoleCursorPosition(console, coord);
+                SetConsoleTextAttribute(console, color);
+                DWORD written = 0;
+                WriteConsoleA(console, run.data(), static_cast<DWORD>(run.size()), &written, nullptr);
+                bytes += run.size();
+                cells += run.size();
+                calls += 3;
+            }
+        }
+        COORD coord;
+        coord.X = cursorX;
+        coord.Y = cursorY;
+        SetConsoleCursorPosition(console, coord);
+        SetConsoleTextAttribute(console, pen);
+        record(bytes, calls + 2, cells);
+    }
+#endif
+
+    static void restore() {
+        Screen& screen = instance();
+        if (!screen.installed) return;
+        present(false);
+        writeOut("\033[0m\n");
+        cout.rdbuf(screen.original);
+        cin.rdbuf(screen.input.source);
+        screen.installed = false;
+    }
+
+public:
+    // Routes cout into the frame; called once when the interactive UI starts
+    static void install() {
+        Screen& screen = instance();
+        if (screen.installed) return;
+
+#ifdef _WIN32
+        HANDLE console = GetStdHandle(STD_OUTPUT_HANDLE);
+        DWORD mode = 0;
+        screen.virtualTerminal = GetConsoleMode(console, &mode) &&
+                                 SetConsoleMode(console, mode | ENABLE_VIRTUAL_TERMINAL_PROCESSING);
+#endif
+        cout.flush();
+        screen.original = cout.rdbuf(&screen.buffer);
+        screen.input.source = cin.rdbuf(&screen.input);
+        screen.installed = true;
+        atexit(restore);
+    }
+
+    static void moveTo(int x, int y) {
+        Screen& screen = instance();
+        screen.cursorX = max(0, x);
+        screen.cursorY = max(0, y);
+    }
+
+    static void setPen(int color) {
+        instance().pen = color;
+    }
+
+    static FrameStats frameStats() {
+        return instance().stats;
+    }
+
+    static void clear() {
+        Screen& screen = instance();
+        for (auto& row : screen.frame) fill(row.begin(), row.end(), blank());
+        screen.cursorX = 0;
+        screen.cursorY = 0;
     }
+
+    // Sends the difference between the frame and the terminal. lineInputFollows marks
+    // the cursor row as possibly echoed on, so the next frame repaints it.
+    static void present(bool lineInputFollows) {
+        Screen& screen = instance();
+        if (!screen.installed) return;
+        screen.ensureRow(screen.cursorY + 1);
+
+        if (screen.echoRow >= 0) {
+            for (int y = screen.echoRow; y <= screen.echoRow + 1 && y < static_cast<int>(screen.shown.size()); y++) {
+                fill(screen.shown[y].begin(), screen.shown[y].end(), Cell{'\0', -1});
+            }
+        }
+        screen.echoRow = lineInputFollows ? screen.cursorY : -1;
+
+#ifdef _WIN32
+        if (!screen.virtualTerminal) {
+            screen.presentLegacy();
+            return;
+        }
 #endif
+        int used = screen.usedRows();
+        if (used > terminalRows()) {
+            screen.presentScrolling(used);
+            return;
+        }
+
+        string out;
+        int atX = screen.terminalX, atY = screen.terminalY, color = screen.terminalColor;
+        size_t cells = 0;
+        if (!screen.cleared) {
+            out += "\033[0m\033[2J";
+            color = COLOR_DEFAULT;
+            screen.cleared = true;
+        }
+
+        for (int y = 0; y < static_cast<int>(screen.frame.size()); y++) {
+            vector<Cell>& row = screen.frame[y];
+            vector<Cell>& onScreen = screen.shown[y];
+            for (int x = 0; x < WIDTH; x++) {
+                if (row[x] == onScreen[x]) continue;
+
+                // Rewriting a short unchanged gap is cheaper than a cursor move
+                if (atY != y || atX > x || x - atX > 4) {
+                    appendMove(out, x, y);
+                } else {
+                    for (int gap = atX; gap < x; gap++) {
+                        if (onScreen[gap].color != color) {
+                            out += ansiColor(onScreen[gap].color);
+                            color = onScreen[gap].color;
+                        }
+                        appendGlyph(out, onScreen[gap].ch);
+                    }
+                }
+
+                if (row[x].color != color) {
+                    out += ansiColor(row[x].color);
+                    color = row[x].color;
+                }
+                appendGlyph(out, row[x].ch);
+                onScreen[x] = row[x];
+                cells++;
+                atX = x + 1;
+                atY = y;
+            }
+        }
+
+        // Leave the terminal cursor and color where typed input should appear
+        if (atX != screen.cursorX || atY != screen.cursorY) appendMove(out, screen.cursorX, screen.cursorY);
+        if (color != screen.pen) out += ansiColor(screen.pen);
+        if (!out.empty()) screen.record(out.size(), writeOut(out), cells);
+
+        // Typed input moves the terminal's cursor behind our back
+        screen.terminalX = lineInputFollows ? -1 : screen.cursorX;
+        screen.terminalY = screen.cursorY;
+        screen.terminalColor = screen.pen;
+    }
+};
+
+// Utility functions
+void gotoxy(int x, int y) {
+    Screen::moveTo(x, y);
+}
+
+void setColor(int color) {
+    Screen::setPen(color);
+}
+
+void clearScreen() {
+    Screen::clear();
 }
 
 void sleepMs(int milliseconds) {
+    Screen::present(false);
 #ifdef _WIN32
     Sleep(milliseconds);
 #else
@@ -90,11 +758,67 @@ void sleepMs(int milliseconds) {
 #endif
 }
 
+int waitForKey() {
+#ifdef _WIN32
+    return _getch();
+#else
+    static int pendingKey = -1;
+    if (pendingKey >= 0) {
+        int key = pendingKey;
+        pendingKey = -1;
+        return key;
+    }
+
+    termios saved;
+    bool terminal = tcgetattr(STDIN_FILENO, &saved) == 0;
+    termios raw = saved;
+    if (terminal) {
+        raw.c_lflag &= ~(ICANON | ECHO);
+        raw.c_cc[VMIN] = 1;
+        raw.c_cc[VTIME] = 0;
+        tcsetattr(STDIN_FILENO, TCSANOW, &raw);
+    }
+
+    unsigned char c = 0;
+    int key = read(STDIN_FILENO, &c, 1) == 1 ? c : 13;
+    if (key == 27 && terminal) {
+        // An escape sequence follows within moments; a lone Esc does not
+        raw.c_cc[VMIN] = 0;
+        raw.c_cc[VTIME] = 1;
+        tcsetattr(STDIN_FILENO, TCSANOW, &raw);
+        unsigned char sequence[2];
+        if (read(STDIN_FILENO, &sequence[0], 1) == 1 && sequence[0] == '[' &&
+            read(STDIN_FILENO, &sequence[1], 1) == 1) {
+            switch (sequence[1]) {
+                case 'A': key = 224; pendingKey = 72; break;
+                case 'B': key = 224; pendingKey = 80; break;
+                case 'C': key = 224; pendingKey = 77; break;
+                case 'D': key = 224; pendingKey = 75; break;
+            }
+        }
+    }
+
+    if (terminal) tcsetattr(STDIN_FILENO, TCSANOW, &saved);
+    if (key == '\n') key = 13;
+    if (key == 127) key = 8;
+    return key;
+#endif
+}
+
+// Reads one key without echo. Arrow keys come back as 224 followed by the scan code
+// and Enter as 13, the way the Windows console reports them.
+int readKey() {
+    Screen::present(false);
+    auto started = chrono::steady_clock::now();
+    int key = waitForKey();
+    PerfCounters::addInputWait(started);
+    return key;
+}
+
 void drawBox(int x, int y, int width, int height, const string& title = "") {
+    const string border(width - 2, char(196));
     gotoxy(x, y);
-    cout << char(218);
-    for (int i = 1; i < width - 1; i++) cout << char(196);
-    cout << char(191);
+    cout << char(218) << border << char(191);
 
     if (!title.empty()) {
         int titleX = x + (width - title.length() - 4) / 2;
@@ -113,9 +837,7 @@ void drawBox(int x, int y, int width, int height, const string& title = "") {
     }
 
     gotoxy(x, y + height - 1);
-    cout << char(192);
-    for (int i = 1; i < width - 1; i++) cout << char(196);
-    cout << char(217);
+    cout << char(192) << border << char(217);
 }
 
 void printCentered(const string& text, int y, int width = 80) {
@@ -125,7 +847,7 @@ void printCentered(const string& text, int y, int width = 80) {
 }
 
 void displayWelcomeBanner() {
-    system("cls");
+    clearScreen();
     setColor(COLOR_CYAN);
     
     printCentered("========================================", 3);
@@ -178,42 +900,693 @@ string getCurrentDateTime() {
     return ss.str();
 }
 
-bool validateRollNo(const string& rollNo) {
-    return !rollNo.empty() && all_of(rollNo.begin(), rollNo.end(), ::isdigit);
-}
-
-bool validateName(const string& name) {
-    return !name.empty() && all_of(name.begin(), name.end(), [](char c) {
-        return isalpha(c) || c == ' ' || c == '.';
-    });
+streamoff getFileSize(const string& filename) {
+    ifstream file(filename, ios::binary | ios::ate);
+    if (!file) return -1;
+    PerfCounters::add(PerfCounters::FILES_OPENED);
+    return file.tellg();
 }
 
-bool validateEmail(const string& email) {
-    return email.find('@') != string::npos && email.find('.') != string::npos;
-}
+// CPU Features - instruction set extensions detected at run time. Only x86 builds with
+// GCC or Clang check; everywhere else the portable code paths are used.
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define SAS_X86_DISPATCH 1
+#endif
 
-void displayMessageBox(const string& message, bool isError = false) {
-    system("cls");
-    int msgWidth = max(static_cast<int>(message.length()) + 8, 40);
-    drawBox(20, 10, msgWidth, 6, isError ? "ERROR" : "MESSAGE");
-    
-    if (isError) {
-        setColor(COLOR_RED);
-    } else {
-        setColor(COLOR_GREEN);
+struct CpuFeatures {
+    static bool popcnt() {
+#ifdef SAS_X86_DISPATCH
+        static const bool supported = __builtin_cpu_supports("popcnt");
+        return supported;
+#else
+        return false;
+#endif
     }
-    
-    gotoxy(22, 12);
-    cout << message;
-    
-    setColor(COLOR_YELLOW);
-    gotoxy(22, 14);
-    cout << "Press any key to continue...";
-    setColor(COLOR_DEFAULT);
-    _getch();
-}
 
-// Student Class
+    static bool sse2() {
+#ifdef SAS_X86_DISPATCH
+        static const bool supported = __builtin_cpu_supports("sse2");
+        return supported;
+#else
+        return false;
+#endif
+    }
+
+    static bool avx2() {
+#ifdef SAS_X86_DISPATCH
+        static const bool supported = __builtin_cpu_supports("avx2");
+        return supported;
+#else
+        return false;
+#endif
+    }
+};
+
+// Bit Count Class
+// Population count over arrays of 64-bit words with the widest kernel the CPU offers:
+// AVX2 nibble lookups for long arrays, the POPCNT instruction, or a portable bit trick.
+class BitCount {
+public:
+    enum Kernel { SCALAR, POPCNT, AVX2 };
+
+private:
+    static int& forced() {
+        static int kernel = -1;
+        return kernel;
+    }
+
+    static uint64_t countScalar(const uint64_t* words, size_t count) {
+        uint64_t total = 0;
+        for (size_t i = 0; i < count; i++) {
+            uint64_t x = words[i];
+            x = x - ((x >> 1) & 0x5555555555555555ULL);
+            x = (x & 0x3333333333333333ULL) + ((x >> 2) & 0x3333333333333333ULL);
+            x = (x + (x >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+            total += (x * 0x0101010101010101ULL) >> 56;
+        }
+        return total;
+    }
+
+#ifdef SAS_X86_DISPATCH
+    __attribute__((target("popcnt")))
+    static uint64_t countPopcnt(const uint64_t* words, size_t count) {
+        uint64_t total = 0;
+        for (size_t i = 0; i < count; i++) total += static_cast<uint64_t>(__builtin_popcountll(words[i]));
+        return total;
+    }
+
+    // Per-byte counts from a 16-entry nibble table, summed into 64-bit lanes with vpsadbw
+    __attribute__((target("avx2,popcnt")))
+    static uint64_t countAvx2(const uint64_t* words, size_t count) {
+        const __m256i table = _mm256_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4,
+                                               0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+        const __m256i nibble = _mm256_set1_epi8(0x0F);
+        __m256i sums = _mm256_setzero_si256();
+        size_t i = 0;
+        for (; i + 4 <= count; i += 4) {
+            __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(words + i));
+            __m256i low = _mm256_shuffle_epi8(table, _mm256_and_si256(v, nibble));
+            __m256i high = _mm256_shuffle_epi8(table, _mm256_and_si256(_mm256_srli_epi16(v, 4), nibble));
+            sums = _mm256_add_epi64(sums, _mm256_sad_epu8(_mm256_add_epi8(low, high), _mm256_setzero_si256()));
+        }
+
+        uint64_t lanes[4];
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(lanes), sums);
+        uint64_t total = lanes[0] + lanes[1] + lanes[2] + lanes[3];
+        for (; i < count; i++) total += static_cast<uint64_t>(__builtin_popcountll(words[i]));
+        return total;
+    }
+#endif
+
+public:
+    // Best kernel this CPU supports, unless one was forced
+    static Kernel kernel() {
+        if (forced() >= 0) return static_cast<Kernel>(forced());
+        if (CpuFeatures::avx2() && CpuFeatures::popcnt()) return AVX2;
+        return CpuFeatures::popcnt() ? POPCNT : SCALAR;
+    }
+
+    // Pins a kernel (for benchmarks); kernels the CPU lacks fall back to the next one down
+    static void setKernel(Kernel kernel) {
+        if (kernel == AVX2 && !(CpuFeatures::avx2() && CpuFeatures::popcnt())) kernel = POPCNT;
+        if (kernel == POPCNT && !CpuFeatures::popcnt()) kernel = SCALAR;
+        forced() = kernel;
+    }
+
+    static const char* kernelName(Kernel kernel) {
+        switch (kernel) {
+            case AVX2: return "avx2";
+            case POPCNT: return "popcnt";
+            default: return "scalar";
+        }
+    }
+
+    static uint64_t words(const uint64_t* data, size_t count) {
+#ifdef SAS_X86_DISPATCH
+        switch (kernel()) {
+            case AVX2: return count >= 16 ? countAvx2(data, count) : countPopcnt(data, count);
+            case POPCNT: return countPopcnt(data, count);
+            default: break;
+        }
+#endif
+        return countScalar(data, count);
+    }
+};
+
+// Index of the lowest set bit of a non-zero word
+inline int countTrailingZeros(uint64_t word) {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_ctzll(word);
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_ARM64))
+    unsigned long index;
+    _BitScanForward64(&index, word);
+    return static_cast<int>(index);
+#else
+    int count = 0;
+    for (; !(word & 1); word >>= 1) count++;
+    return count;
+#endif
+}
+
+// CRC-32 (IEEE) used to validate blocks in the binary data files
+uint32_t crc32(const char* data, size_t size, uint32_t crc = 0) {
+    static uint32_t table[256];
+    static bool tableReady = false;
+    if (!tableReady) {
+        for (uint32_t i = 0; i < 256; i++) {
+            uint32_t c = i;
+            for (int k = 0; k < 8; k++) c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+            table[i] = c;
+        }
+        tableReady = true;
+    }
+
+    crc = ~crc;
+    for (size_t i = 0; i < size; i++) {
+        crc = table[(crc ^ static_cast<unsigned char>(data[i])) & 0xFF] ^ (crc >> 8);
+    }
+    return ~crc;
+}
+
+// Writes data to an open file, forces it to disk and closes the file
+bool writeAndSync(int fd, const string& data) {
+    size_t written = 0;
+    bool ok = true;
+    while (ok && written < data.size()) {
+#ifdef _WIN32
+        int n = _write(fd, data.data() + written, static_cast<unsigned>(data.size() - written));
+#else
+        ssize_t n = write(fd, data.data() + written, data.size() - written);
+#endif
+        if (n <= 0) ok = false;
+        else written += static_cast<size_t>(n);
+    }
+
+#ifdef _WIN32
+    ok = ok && _commit(fd) == 0;
+    _close(fd);
+#else
+    ok = ok && fsync(fd) == 0;
+    close(fd);
+#endif
+    return ok;
+}
+
+// Appends data with a single write call and forces it to disk before returning
+bool appendDurably(const string& filename, const string& data) {
+#ifdef _WIN32
+    int fd = _open(filename.c_str(), _O_WRONLY | _O_APPEND | _O_CREAT | _O_BINARY, _S_IREAD | _S_IWRITE);
+#else
+    int fd = open(filename.c_str(), O_WRONLY | O_APPEND | O_CREAT, 0644);
+#endif
+    if (fd < 0) return false;
+    return writeAndSync(fd, data);
+}
+
+// Replaces a file by writing a temporary copy, syncing it and renaming it over the original.
+// Each copy is created under a name of its own (process id and a counter), so concurrent
+// writers of the same file never share one; the last rename wins. The directory is
+// synced afterwards so that the rename itself survives a crash.
+bool writeFileAtomically(const string& filename, const string& data) {
+    static atomic<unsigned> sequence(0);
+#ifdef _WIN32
+    string prefix = filename + "." + to_string(GetCurrentProcessId()) + ".";
+#else
+    string prefix = filename + "." + to_string(getpid()) + ".";
+#endif
+
+    // A name left behind by a crashed process with the same id is skipped
+    string tempName;
+    int fd = -1;
+    for (int attempt = 0; fd < 0 && attempt < 16; attempt++) {
+        tempName = prefix + to_string(sequence++) + ".tmp";
+#ifdef _WIN32
+        fd = _open(tempName.c_str(), _O_WRONLY | _O_CREAT | _O_EXCL | _O_TRUNC | _O_BINARY, _S_IREAD | _S_IWRITE);
+#else
+        fd = open(tempName.c_str(), O_WRONLY | O_CREAT | O_EXCL | O_TRUNC, 0644);
+#endif
+        if (fd < 0 && errno != EEXIST) return false;
+    }
+    if (fd < 0) return false;
+
+    error_code ec;
+    if (!writeAndSync(fd, data)) {
+        filesystem::remove(tempName, ec);
+        return false;
+    }
+    filesystem::rename(tempName, filename, ec);
+    if (ec) {
+        error_code ignored;
+        filesystem::remove(tempName, ignored);
+        return false;
+    }
+
+#ifndef _WIN32
+    string directory = filesystem::path(filename).parent_path().string();
+    int dir = open(directory.empty() ? "." : directory.c_str(), O_RDONLY);
+    if (dir >= 0) {
+        fsync(dir);
+        close(dir);
+    }
+#endif
+    return true;
+}
+
+// Dates are YYYY-MM-DD strings on screen and day numbers (days since 1970-01-01) in storage
+const int INVALID_DAY = INT_MIN;
+
+int dateToDays(const string& date) {
+    if (date.length() != 10 || date[4] != '-' || date[7] != '-') return INVALID_DAY;
+    for (int i : {0, 1, 2, 3, 5, 6, 8, 9}) {
+        if (!isdigit(static_cast<unsigned char>(date[i]))) return INVALID_DAY;
+    }
+
+    int y = (date[0] - '0') * 1000 + (date[1] - '0') * 100 + (date[2] - '0') * 10 + (date[3] - '0');
+    int m = (date[5] - '0') * 10 + (date[6] - '0');
+    int d = (date[8] - '0') * 10 + (date[9] - '0');
+    if (m < 1 || m > 12 || d < 1 || d > 31) return INVALID_DAY;
+
+    y -= m <= 2;
+    int era = y / 400;
+    int yoe = y - era * 400;
+    int doy = (153 * (m > 2 ? m - 3 : m + 9) + 2) / 5 + d - 1;
+    int doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+    return era * 146097 + doe - 719468;
+}
+
+string daysToDate(int days) {
+    days += 719468;
+    int era = days / 146097;
+    int doe = days - era * 146097;
+    int yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+    int doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+    int mp = (5 * doy + 2) / 153;
+    int d = doy - (153 * mp + 2) / 5 + 1;
+    int m = mp < 10 ? mp + 3 : mp - 9;
+    int y = yoe + era * 400 + (m <= 2);
+
+    char buffer[32];
+    snprintf(buffer, sizeof(buffer), "%04d-%02d-%02d", y, m, d);
+    return buffer;
+}
+
+// First and last day number of a YYYY-MM month
+bool monthToDayRange(const string& monthYear, int& firstDay, int& lastDay) {
+    if (monthYear.length() != 7) return false;
+    firstDay = dateToDays(monthYear + "-01");
+    if (firstDay == INVALID_DAY) return false;
+
+    int year = stoi(monthYear.substr(0, 4));
+    int month = stoi(monthYear.substr(5, 2));
+    char next[32];
+    snprintf(next, sizeof(next), "%04d-%02d-01", month == 12 ? year + 1 : year, month == 12 ? 1 : month + 1);
+    lastDay = dateToDays(next) - 1;
+    return true;
+}
+
+bool validateRollNo(const string& rollNo) {
+    return !rollNo.empty() && all_of(rollNo.begin(), rollNo.end(), ::isdigit);
+}
+
+bool validateName(const string& name) {
+    return !name.empty() && all_of(name.begin(), name.end(), [](char c) {
+        return isalpha(c) || c == ' ' || c == '.';
+    });
+}
+
+bool validateEmail(const string& email) {
+    return email.find('@') != string::npos && email.find('.') != string::npos;
+}
+
+void displayMessageBox(const string& message, bool isError = false) {
+    clearScreen();
+    int msgWidth = max(static_cast<int>(message.length()) + 8, 40);
+    drawBox(20, 10, msgWidth, 6, isError ? "ERROR" : "MESSAGE");
+    
+    if (isError) {
+        setColor(COLOR_RED);
+    } else {
+        setColor(COLOR_GREEN);
+    }
+    
+    gotoxy(22, 12);
+    cout << message;
+    
+    setColor(COLOR_YELLOW);
+    gotoxy(22, 14);
+    cout << "Press any key to continue...";
+    setColor(COLOR_DEFAULT);
+    readKey();
+}
+
+// Mapped File Class
+// Read-only memory mapping of a whole data file. An empty or missing file maps to
+// zero bytes; isOpen() tells the two apart.
+class MappedFile {
+private:
+    const char* data;
+    size_t length;
+    bool opened;
+#ifdef _WIN32
+    HANDLE file;
+    HANDLE mapping;
+#else
+    int fd;
+#endif
+
+public:
+    explicit MappedFile(const string& filename) : data(nullptr), length(0), opened(false) {
+#ifdef _WIN32
+        mapping = NULL;
+        file = CreateFileA(filename.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE, NULL,
+                           OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+        if (file == INVALID_HANDLE_VALUE) return;
+        opened = true;
+        PerfCounters::add(PerfCounters::FILES_OPENED);
+
+        LARGE_INTEGER size;
+        if (!GetFileSizeEx(file, &size) || size.QuadPart == 0) return;
+        mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+        if (mapping == NULL) return;
+        data = static_cast<const char*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+        if (data) length = static_cast<size_t>(size.QuadPart);
+#else
+        fd = open(filename.c_str(), O_RDONLY);
+        if (fd < 0) return;
+        opened = true;
+        PerfCounters::add(PerfCounters::FILES_OPENED);
+
+        struct stat info;
+        if (fstat(fd, &info) != 0 || info.st_size == 0) return;
+        void* view = mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+        if (view == MAP_FAILED) return;
+        data = static_cast<const char*>(view);
+        length = static_cast<size_t>(info.st_size);
+#endif
+        PerfCounters::add(PerfCounters::BYTES_READ, length);
+    }
+
+    ~MappedFile() {
+#ifdef _WIN32
+        if (data) UnmapViewOfFile(data);
+        if (mapping != NULL) CloseHandle(mapping);
+        if (file != INVALID_HANDLE_VALUE) CloseHandle(file);
+#else
+        if (data) munmap(const_cast<char*>(data), length);
+        if (fd >= 0) close(fd);
+#endif
+    }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    bool isOpen() const { return opened; }
+    const char* begin() const { return data; }
+    size_t size() const { return length; }
+};
+
+// Delimiter Scanner Class
+// Finds every '|' and '\n' in a 64-byte block at once and returns them as bit masks
+// (bit i = byte i). The widest kernel the CPU offers is picked at run time.
+class DelimiterScanner {
+public:
+    enum Kernel { SCALAR, SSE2, AVX2 };
+
+    struct Masks {
+        uint64_t pipes;
+        uint64_t newlines;
+    };
+
+    typedef Masks (*Function)(const char* block);
+
+    static const size_t BLOCK = 64;
+
+private:
+    static int& forced() {
+        static int kernel = -1;
+        return kernel;
+    }
+
+    // One bit per byte of a little-endian word that equals the pattern byte: exact
+    // zero-byte detection on word ^ pattern, then the byte flags gathered by a multiply
+    static uint64_t matchBytes(uint64_t word, uint64_t pattern) {
+        const uint64_t low7 = 0x7F7F7F7F7F7F7F7FULL;
+        uint64_t x = word ^ pattern;
+        uint64_t zero = ~(((x & low7) + low7) | x | low7);
+        return ((zero >> 7) * 0x0102040810204080ULL) >> 56;
+    }
+
+    static Masks scanScalar(const char* block) {
+        Masks masks = {0, 0};
+        for (size_t i = 0; i < BLOCK; i += 8) {
+            uint64_t word;
+            memcpy(&word, block + i, sizeof(word));
+            masks.pipes |= matchBytes(word, 0x7C7C7C7C7C7C7C7CULL) << i;
+            masks.newlines |= matchBytes(word, 0x0A0A0A0A0A0A0A0AULL) << i;
+        }
+        return masks;
+    }
+
+#ifdef SAS_X86_DISPATCH
+    __attribute__((target("sse2")))
+    static Masks scanSse2(const char* block) {
+        const __m128i pipe = _mm_set1_epi8('|');
+        const __m128i newline = _mm_set1_epi8('\n');
+        Masks masks = {0, 0};
+        for (size_t i = 0; i < BLOCK; i += 16) {
+            __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(block + i));
+            masks.pipes |= uint64_t(static_cast<uint16_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(v, pipe)))) << i;
+            masks.newlines |= uint64_t(static_cast<uint16_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(v, newline)))) << i;
+        }
+        return masks;
+    }
+
+    __attribute__((target("avx2")))
+    static Masks scanAvx2(const char* block) {
+        const __m256i pipe = _mm256_set1_epi8('|');
+        const __m256i newline = _mm256_set1_epi8('\n');
+        __m256i low = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(block));
+        __m256i high = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(block + 32));
+        Masks masks;
+        masks.pipes = uint64_t(static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(low, pipe)))) |
+                      uint64_t(static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(high, pipe)))) << 32;
+        masks.newlines = uint64_t(static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(low, newline)))) |
+                         uint64_t(static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(high, newline)))) << 32;
+        return masks;
+    }
+#endif
+
+public:
+    // Best kernel this CPU supports, unless one was forced
+    static Kernel kernel() {
+        if (forced() >= 0) return static_cast<Kernel>(forced());
+        if (CpuFeatures::avx2()) return AVX2;
+        return CpuFeatures::sse2() ? SSE2 : SCALAR;
+    }
+
+    // Pins a kernel (for benchmarks); kernels the CPU lacks fall back to the next one down
+    static void setKernel(Kernel kernel) {
+        if (kernel == AVX2 && !CpuFeatures::avx2()) kernel = SSE2;
+        if (kernel == SSE2 && !CpuFeatures::sse2()) kernel = SCALAR;
+        forced() = kernel;
+    }
+
+    static const char* kernelName(Kernel kernel) {
+        switch (kernel) {
+            case AVX2: return "avx2";
+            case SSE2: return "sse2";
+            default: return "scalar";
+        }
+    }
+
+    static Function function() {
+#ifdef SAS_X86_DISPATCH
+        switch (kernel()) {
+            case AVX2: return scanAvx2;
+            case SSE2: return scanSse2;
+            default: break;
+        }
+#endif
+        return scanScalar;
+    }
+};
+
+// Record Reader Class
+// Walks pipe-delimited lines and hands out fields as string_views into the
+// underlying bytes (a mapped file or any other buffer that outlives the views).
+// Delimiters are located a block at a time by the DelimiterScanner; the reader then
+// only visits the set bits. A short final block is scanned from a zero-padded copy.
+class RecordReader {
+private:
+    const char* cursor;
+    const char* end;
+    const char* block;              // start of the block the masks describe
+    DelimiterScanner::Masks masks;  // delimiters in the block not yet consumed
+    DelimiterScanner::Function scan;
+    char padded[DelimiterScanner::BLOCK];
+
+    void load(const char* at) {
+        block = at;
+        size_t available = static_cast<size_t>(end - at);
+        if (available >= DelimiterScanner::BLOCK) {
+            masks = scan(at);
+        } else {
+            for (size_t i = 0; i < DelimiterScanner::BLOCK; i++) padded[i] = i < available ? at[i] : 0;
+            masks = scan(padded);
+        }
+    }
+
+    // Position of the next delimiter (end if none is left) and whether it is a pipe
+    const char* nextDelimiter(bool& pipe) {
+        uint64_t pending = masks.pipes | masks.newlines;
+        while (pending == 0) {
+            if (end - block <= static_cast<ptrdiff_t>(DelimiterScanner::BLOCK)) {
+                pipe = false;
+                return end;
+            }
+            load(block + DelimiterScanner::BLOCK);
+            pending = masks.pipes | masks.newlines;
+        }
+        int offset = countTrailingZeros(pending);
+        uint64_t bit = uint64_t(1) << offset;
+        pipe = (masks.pipes & bit) != 0;
+        masks.pipes &= ~bit;
+        masks.newlines &= ~bit;
+        return block + offset;
+    }
+
+public:
+    RecordReader(const char* data, size_t size)
+        : cursor(data), end(data + size), scan(DelimiterScanner::function()) {
+        load(data);
+    }
+    explicit RecordReader(const MappedFile& file) : RecordReader(file.begin(), file.size()) {}
+
+    RecordReader(const RecordReader&) = delete;
+    RecordReader& operator=(const RecordReader&) = delete;
+
+    // Splits the next non-empty line into fields; returns false once the data is exhausted
+    bool next(vector<string_view>& fields) {
+        while (cursor < end) {
+            const char* lineStart = cursor;
+            const char* fieldStart = cursor;
+            fields.clear();
+
+            bool pipe;
+            const char* lineEnd = nextDelimiter(pipe);
+            while (pipe) {
+                fields.emplace_back(fieldStart, lineEnd - fieldStart);
+                fieldStart = lineEnd + 1;
+                lineEnd = nextDelimiter(pipe);
+            }
+            cursor = lineEnd < end ? lineEnd + 1 : end;
+
+            const char* last = lineEnd;
+            if (last > lineStart && last[-1] == '\r') last--;
+            if (last == lineStart) continue;
+
+            fields.emplace_back(fieldStart, last - fieldStart);
+            PerfCounters::add(PerfCounters::RECORDS_PARSED);
+            return true;
+        }
+        return false;
+    }
+};
+
+// Field helpers for RecordReader output (missing fields read as empty)
+string_view fieldAt(const vector<string_view>& fields, size_t index) {
+    return index < fields.size() ? fields[index] : string_view();
+}
+
+template <typename Number>
+Number parseNumber(string_view field, Number fallback) {
+    Number value = fallback;
+    if (from_chars(field.data(), field.data() + field.size(), value).ec != errc()) return fallback;
+    return value;
+}
+
+// Binary Writer/Reader - little helpers for the binary data files (host byte order)
+class BinaryWriter {
+private:
+    string& buffer;
+
+public:
+    BinaryWriter(string& out) : buffer(out) {}
+
+    template <typename T>
+    void write(T value) {
+        buffer.append(reinterpret_cast<const char*>(&value), sizeof(T));
+    }
+
+    template <typename T>
+    void writeArray(const vector<T>& values) {
+        if (!values.empty()) buffer.append(reinterpret_cast<const char*>(values.data()), values.size() * sizeof(T));
+    }
+
+    void writeString(const string& value) {
+        write<uint16_t>(static_cast<uint16_t>(value.length()));
+        buffer.append(value, 0, static_cast<uint16_t>(value.length()));
+    }
+};
+
+class BinaryReader {
+private:
+    const char* data;
+    size_t size;
+    size_t pos;
+    bool good;
+
+public:
+    BinaryReader(const char* d, size_t n) : data(d), size(n), pos(0), good(true) {}
+
+    bool ok() const { return good; }
+    size_t position() const { return pos; }
+
+    template <typename T>
+    T read() {
+        T value = T();
+        if (!good || size - pos < sizeof(T)) {
+            good = false;
+            return value;
+        }
+        memcpy(&value, data + pos, sizeof(T));
+        pos += sizeof(T);
+        return value;
+    }
+
+    template <typename T>
+    void readArray(vector<T>& values, size_t count) {
+        if (!good || (size - pos) / sizeof(T) < count) {
+            good = false;
+            return;
+        }
+        size_t offset = values.size();
+        values.resize(offset + count);
+        if (count > 0) memcpy(values.data() + offset, data + pos, count * sizeof(T));
+        pos += count * sizeof(T);
+    }
+
+    void skip(size_t count) {
+        if (!good || size - pos < count) {
+            good = false;
+            return;
+        }
+        pos += count;
+    }
+
+    string readString() {
+        uint16_t length = read<uint16_t>();
+        if (!good || size - pos < length) {
+            good = false;
+            return "";
+        }
+        string value(data + pos, length);
+        pos += length;
+        return value;
+    }
+};
+
+// Student Class
 class Student {
 private:
     string rollNo;
@@ -226,7 +1599,7 @@ private:
 public:
     Student() : rollNo(""), name(""), department(""), semester(0), email(""), phone("") {}
     Student(string r, string n, string d, int s, string e = "", string p = "") 
-        : rollNo(r), name(n), department(d), semester(s), email(e), phone(p) {}
+        : rollNo(move(r)), name(move(n)), department(move(d)), semester(s), email(move(e)), phone(move(p)) {}
 
     string getRollNo() const { return rollNo; }
     string getName() const { return name; }
@@ -256,34 +1629,18 @@ public:
     void setEmail(const string& e) { email = e; }
     void setPhone(const string& p) { phone = p; }
 
-    void saveToFile(ofstream& file) const {
+    void saveToFile(ostream& file) const {
         file << rollNo << "|" << name << "|" << department << "|" << semester 
              << "|" << email << "|" << phone << endl;
     }
 
-    bool loadFromFile(ifstream& file) {
-        string line;
-        if (getline(file, line)) {
-            stringstream ss(line);
-            string token;
-            
-            getline(ss, rollNo, '|');
-            getline(ss, name, '|');
-            getline(ss, department, '|');
-            
-            getline(ss, token, '|');
-            try {
-                semester = stoi(token);
-            } catch (...) {
-                semester = 0;
-            }
-            
-            getline(ss, email, '|');
-            getline(ss, phone, '|');
-            
-            return true;
-        }
-        return false;
+    void loadFromFields(const vector<string_view>& fields) {
+        rollNo = string(fieldAt(fields, 0));
+        name = string(fieldAt(fields, 1));
+        department = string(fieldAt(fields, 2));
+        semester = parseNumber(fieldAt(fields, 3), 0);
+        email = string(fieldAt(fields, 4));
+        phone = string(fieldAt(fields, 5));
     }
 
     void displayInfo() const {
@@ -296,403 +1653,3847 @@ public:
     }
 };
 
-// Exam Result Class
-class ExamResult {
+// Loads every record of a pipe-delimited data file through a RecordReader
+template <typename Record>
+vector<Record> loadAllRecords(const string& filename) {
+    vector<Record> records;
+    MappedFile file(filename);
+    RecordReader reader(file);
+    vector<string_view> fields;
+
+    while (reader.next(fields)) {
+        Record record;
+        record.loadFromFields(fields);
+        records.push_back(record);
+    }
+    return records;
+}
+
+// Student Store Class
+// students.txt is a snapshot; every add/update/delete since the snapshot is one
+// fsynced line in students.log ("A|<record>", "U|<record>", "D|<rollNo>"). Loading
+// replays the log over the snapshot. Replay is idempotent (adds and updates are
+// upserts), so a crash between a compaction's rename and its log reset is harmless.
+class StudentStore {
 private:
-    string rollNo;
-    string semester;
-    string subject;
-    double marks;
-    string grade;
-    string examType;
+    static const size_t MIN_COMPACT_ENTRIES = 128;
+
+    size_t logEntries;
+
+    StudentStore() : logEntries(0) {}
+
+    static StudentStore& instance() {
+        static StudentStore store;
+        return store;
+    }
+
+    // Length of the log up to its last complete line; a torn final line is ignored
+    static size_t completeLength(const MappedFile& file) {
+        size_t length = file.size();
+        while (length > 0 && file.begin()[length - 1] != '\n') length--;
+        return length;
+    }
+
+    static bool appendLines(const string& lines, size_t entries) {
+        // Drop a torn line left by a crash so the new entry starts on its own line
+        streamoff size = getFileSize(STUDENT_LOG_FILE);
+        if (size > 0) {
+            size_t complete;
+            {
+                MappedFile log(STUDENT_LOG_FILE);
+                complete = completeLength(log);
+            }
+            if (static_cast<streamoff>(complete) != size) {
+                error_code ec;
+                filesystem::resize_file(STUDENT_LOG_FILE, complete, ec);
+                if (ec) return false;
+            }
+        }
+
+        if (!appendDurably(STUDENT_LOG_FILE, lines)) return false;
+
+        instance().logEntries += entries;
+        return true;
+    }
+
+    static string entryOf(char op, const string& body) {
+        string line;
+        line += op;
+        line += '|';
+        line += body;
+        line += '\n';
+        return line;
+    }
+
+    static string recordOf(const Student& student) {
+        ostringstream out;
+        student.saveToFile(out);
+        string record = out.str();
+        if (!record.empty() && record.back() == '\n') record.pop_back();
+        return record;
+    }
+
+public:
+    // Snapshot plus replayed log, in insertion order
+    static vector<Student> load() {
+        vector<Student> students = loadAllRecords<Student>(STUDENT_FILE);
+        unordered_map<string, size_t> positions;
+        for (size_t i = 0; i < students.size(); i++) positions[students[i].getRollNo()] = i;
+
+        vector<bool> removed(students.size(), false);
+        size_t entries = 0;
+
+        MappedFile log(STUDENT_LOG_FILE);
+        RecordReader reader(log.begin(), completeLength(log));
+        vector<string_view> fields;
+        while (reader.next(fields)) {
+            if (fields.size() < 2 || fields[0].size() != 1) continue;
+            entries++;
+
+            char op = fields[0][0];
+            string rollNo(fields[1]);
+            auto it = positions.find(rollNo);
+
+            if (op == 'D') {
+                if (it != positions.end()) {
+                    removed[it->second] = true;
+                    positions.erase(it);
+                }
+            } else if (op == 'A' || op == 'U') {
+                Student student;
+                student.loadFromFields(vector<string_view>(fields.begin() + 1, fields.end()));
+                if (it != positions.end()) {
+                    students[it->second] = student;
+                } else {
+                    positions[rollNo] = students.size();
+                    students.push_back(student);
+                    removed.push_back(false);
+                }
+            }
+        }
+
+        vector<Student> live;
+        live.reserve(positions.size());
+        for (size_t i = 0; i < students.size(); i++) {
+            if (!removed[i]) live.push_back(students[i]);
+        }
+
+        instance().logEntries = entries;
+        return live;
+    }
+
+    static bool logAdd(const Student& student) {
+        return appendLines(entryOf('A', recordOf(student)), 1);
+    }
+
+    // Logs several additions with a single write and fsync
+    static bool logAdds(const vector<Student>& students) {
+        string lines;
+        for (const auto& student : students) {
+            lines += entryOf('A', recordOf(student));
+        }
+        return appendLines(lines, students.size());
+    }
+
+    static bool logUpdate(const Student& student) {
+        return appendLines(entryOf('U', recordOf(student)), 1);
+    }
+
+    static bool logDelete(const string& rollNo) {
+        return appendLines(entryOf('D', rollNo), 1);
+    }
+
+    // Writes a fresh snapshot, swaps it in with an atomic rename and resets the log
+    static bool compact(const vector<Student>& students) {
+        ostringstream snapshot;
+        for (const auto& student : students) {
+            student.saveToFile(snapshot);
+        }
+        if (!writeFileAtomically(STUDENT_FILE, snapshot.str())) return false;
+
+        error_code ec;
+        filesystem::remove(STUDENT_LOG_FILE, ec);
+        instance().logEntries = 0;
+        return !ec;
+    }
+
+    // True once the log has grown to a fair share of the table, keeping edits amortized O(1)
+    static bool needsCompaction(size_t studentCount) {
+        size_t entries = instance().logEntries;
+        return entries >= MIN_COMPACT_ENTRIES && entries * 2 >= studentCount;
+    }
+};
+
+// Student Repository Class
+// In-memory student table with a hash index on roll number and ordered secondary
+// indexes on department, semester and the pair of both. Rows are never moved, so
+// deletes leave a tombstone until enough accumulate to repack the table. The table
+// reloads itself when students.txt or students.log change behind its back.
+class StudentRepository {
+private:
+    struct FileStamp {
+        streamoff snapshotSize = -1;
+        streamoff logSize = -1;
+        filesystem::file_time_type snapshotTime;
+        filesystem::file_time_type logTime;
+
+        bool operator==(const FileStamp& other) const {
+            return snapshotSize == other.snapshotSize && logSize == other.logSize &&
+                   snapshotTime == other.snapshotTime && logTime == other.logTime;
+        }
+    };
+
+    vector<Student> rows;
+    vector<bool> live;
+    size_t liveCount;
+    unordered_map<string, size_t> byRoll;
+    map<string, set<size_t>> byDepartment;
+    map<int, set<size_t>> bySemester;
+    map<pair<string, int>, set<size_t>> byDepartmentSemester;
+    FileStamp stamp;
+    bool loaded;
+    unsigned long generation;
+
+    StudentRepository() : liveCount(0), loaded(false), generation(0) {}
+
+    static StudentRepository& raw() {
+        static StudentRepository repository;
+        return repository;
+    }
+
+    static StudentRepository& instance() {
+        ensureLoaded();
+        return raw();
+    }
+
+    static FileStamp currentStamp() {
+        FileStamp current;
+        error_code ec;
+        current.snapshotSize = getFileSize(STUDENT_FILE);
+        current.logSize = getFileSize(STUDENT_LOG_FILE);
+        if (current.snapshotSize >= 0) current.snapshotTime = filesystem::last_write_time(STUDENT_FILE, ec);
+        if (current.logSize >= 0) current.logTime = filesystem::last_write_time(STUDENT_LOG_FILE, ec);
+        return current;
+    }
+
+    static void ensureLoaded() {
+        StudentRepository& repository = raw();
+        FileStamp current = currentStamp();
+        if (repository.loaded && repository.stamp == current) return;
+
+        repository.rebuild(StudentStore::load());
+        repository.stamp = current;
+        repository.loaded = true;
+        repository.generation++;
+    }
+
+    void rebuild(vector<Student> students) {
+        byRoll.clear();
+        byDepartment.clear();
+        bySemester.clear();
+        byDepartmentSemester.clear();
+
+        rows = move(students);
+        live.assign(rows.size(), true);
+        liveCount = rows.size();
+        byRoll.reserve(rows.size());
+        for (size_t row = 0; row < rows.size(); row++) {
+            byRoll[rows[row].getRollNo()] = row;
+            indexRow(row);
+        }
+    }
+
+    void insertRow(const Student& student) {
+        size_t row = rows.size();
+        rows.push_back(student);
+        live.push_back(true);
+        liveCount++;
+        byRoll[student.getRollNo()] = row;
+        indexRow(row);
+    }
+
+    // New rows always have the highest number, so the end of each set is the right hint
+    void indexRow(size_t row) {
+        const Student& student = rows[row];
+        set<size_t>& department = byDepartment[student.getDepartment()];
+        department.insert(department.end(), row);
+        set<size_t>& semester = bySemester[student.getSemester()];
+        semester.insert(semester.end(), row);
+        set<size_t>& both = byDepartmentSemester[{student.getDepartment(), student.getSemester()}];
+        both.insert(both.end(), row);
+    }
+
+    template<typename Key>
+    static void unindex(map<Key, set<size_t>>& index, const Key& key, size_t row) {
+        auto it = index.find(key);
+        if (it == index.end()) return;
+        it->second.erase(row);
+        if (it->second.empty()) index.erase(it);
+    }
+
+    void unindexRow(size_t row) {
+        const Student& student = rows[row];
+        unindex(byDepartment, student.getDepartment(), row);
+        unindex(bySemester, student.getSemester(), row);
+        unindex(byDepartmentSemester, make_pair(student.getDepartment(), student.getSemester()), row);
+    }
+
+    vector<Student> rowsOf(const set<size_t>* matches) const {
+        vector<Student> result;
+        if (!matches) return result;
+        result.reserve(matches->size());
+        for (size_t row : *matches) {
+            result.push_back(rows[row]);
+        }
+        return result;
+    }
+
+    // Our own writes change the file stamps; record them so they don't force a reload
+    void afterWrite() {
+        if (StudentStore::needsCompaction(liveCount)) {
+            StudentStore::compact(listLive());
+        }
+        if (rows.size() > 64 && liveCount * 2 < rows.size()) {
+            rebuild(listLive());
+        }
+        stamp = currentStamp();
+        generation++;
+    }
+
+    vector<Student> listLive() const {
+        vector<Student> result;
+        result.reserve(liveCount);
+        for (size_t row = 0; row < rows.size(); row++) {
+            if (live[row]) result.push_back(rows[row]);
+        }
+        return result;
+    }
+
+public:
+    static bool exists(const string& rollNo) {
+        const StudentRepository& repository = instance();
+        return repository.byRoll.count(rollNo) > 0;
+    }
+
+    // Membership of many roll numbers at once, checking the files for changes only once
+    static vector<bool> existing(const vector<string>& rollNos) {
+        const StudentRepository& repository = instance();
+        vector<bool> result(rollNos.size());
+        for (size_t i = 0; i < rollNos.size(); i++) {
+            result[i] = repository.byRoll.count(rollNos[i]) > 0;
+        }
+        return result;
+    }
+
+    // Copy of the student with the given roll number, or false if there is none
+    static bool find(const string& rollNo, Student& student) {
+        const StudentRepository& repository = instance();
+        auto it = repository.byRoll.find(rollNo);
+        if (it == repository.byRoll.end()) return false;
+        student = repository.rows[it->second];
+        PerfCounters::add(PerfCounters::RECORDS_MATCHED);
+        return true;
+    }
+
+    static size_t count() {
+        return instance().liveCount;
+    }
+
+    // Bumped whenever the table is reloaded or written, so that anything derived from
+    // it can tell an edit that kept the row count (or came from another session)
+    static unsigned long getGeneration() {
+        return instance().generation;
+    }
+
+    // All students in insertion order
+    static vector<Student> all() {
+        return instance().listLive();
+    }
+
+    // Students matching a department and/or semester; an empty department or a
+    // semester of 0 leaves that criterion out. Answered from the secondary indexes.
+    static vector<Student> filter(const string& department, int semester = 0) {
+        const StudentRepository& repository = instance();
+        if (department.empty() && semester == 0) return repository.listLive();
+
+        const set<size_t>* matches = nullptr;
+        if (!department.empty() && semester != 0) {
+            auto it = repository.byDepartmentSemester.find({department, semester});
+            if (it != repository.byDepartmentSemester.end()) matches = &it->second;
+        } else if (!department.empty()) {
+            auto it = repository.byDepartment.find(department);
+            if (it != repository.byDepartment.end()) matches = &it->second;
+        } else {
+            auto it = repository.bySemester.find(semester);
+            if (it != repository.bySemester.end()) matches = &it->second;
+        }
+        vector<Student> students = repository.rowsOf(matches);
+        PerfCounters::add(PerfCounters::RECORDS_MATCHED, students.size());
+        return students;
+    }
+
+    static bool add(const Student& student) {
+        StudentRepository& repository = instance();
+        if (repository.byRoll.count(student.getRollNo())) return false;
+        if (!StudentStore::logAdd(student)) return false;
+
+        repository.insertRow(student);
+        repository.afterWrite();
+        return true;
+    }
+
+    // Adds students with new, distinct roll numbers as one logged batch
+    static bool addBatch(const vector<Student>& students) {
+        StudentRepository& repository = instance();
+        for (const auto& student : students) {
+            if (repository.byRoll.count(student.getRollNo())) return false;
+        }
+        if (!StudentStore::logAdds(students)) return false;
+
+        repository.rows.reserve(repository.rows.size() + students.size());
+        for (const auto& student : students) {
+            repository.insertRow(student);
+        }
+        repository.afterWrite();
+        return true;
+    }
+
+    static bool update(const Student& student) {
+        StudentRepository& repository = instance();
+        auto it = repository.byRoll.find(student.getRollNo());
+        if (it == repository.byRoll.end()) return false;
+        if (!StudentStore::logUpdate(student)) return false;
+
+        size_t row = it->second;
+        repository.unindexRow(row);
+        repository.rows[row] = student;
+        repository.indexRow(row);
+        repository.afterWrite();
+        return true;
+    }
+
+    static bool remove(const string& rollNo) {
+        StudentRepository& repository = instance();
+        auto it = repository.byRoll.find(rollNo);
+        if (it == repository.byRoll.end()) return false;
+        if (!StudentStore::logDelete(rollNo)) return false;
+
+        size_t row = it->second;
+        repository.unindexRow(row);
+        repository.byRoll.erase(it);
+        repository.live[row] = false;
+        repository.liveCount--;
+        repository.afterWrite();
+        return true;
+    }
+
+    // Warm start image: the live rows in order
+    static void saveWarmStart(BinaryWriter& writer) {
+        const StudentRepository& repository = instance();
+        writer.write<uint32_t>(static_cast<uint32_t>(repository.liveCount));
+        for (size_t row = 0; row < repository.rows.size(); row++) {
+            if (!repository.live[row]) continue;
+            const Student& student = repository.rows[row];
+            writer.writeString(student.getRollNo());
+            writer.writeString(student.getName());
+            writer.writeString(student.getDepartment());
+            writer.write<int32_t>(student.getSemester());
+            writer.writeString(student.getEmail());
+            writer.writeString(student.getPhone());
+        }
+    }
+
+    static bool loadWarmStart(BinaryReader& reader) {
+        uint32_t count = reader.read<uint32_t>();
+        vector<Student> students;
+        students.reserve(count);
+        for (uint32_t i = 0; i < count && reader.ok(); i++) {
+            string rollNo = reader.readString();
+            string name = reader.readString();
+            string department = reader.readString();
+            int semester = reader.read<int32_t>();
+            string email = reader.readString();
+            string phone = reader.readString();
+            students.emplace_back(move(rollNo), move(name), move(department), semester, move(email), move(phone));
+        }
+        if (!reader.ok()) return false;
+
+        StudentRepository& repository = raw();
+        repository.rebuild(move(students));
+        repository.stamp = currentStamp();
+        repository.loaded = true;
+        repository.generation++;
+        return true;
+    }
+};
+
+// Student Account Class
+struct StudentAccount {
+    string username;
+    string password;    // stored encrypted, as kept in Person
+    string rollNo;
+    string name;
+};
+
+// Student Account Store Class
+// One "username|password|rollNo|name" line per account in student_accounts.txt, with
+// the encrypted password hex-encoded so that no byte of it can clash with '|' or a
+// line break. A password change appends a newer line for the same username; the last
+// line wins. Lookups go through a hash index on username and a unique index on roll.
+class StudentAccountStore {
+private:
+    vector<StudentAccount> accounts;
+    unordered_map<string, size_t> byUsername;
+    unordered_map<string, size_t> byRollNo;
+    size_t supersededLines;
+    streamoff loadedSize;
+    bool loaded;
+
+    StudentAccountStore() : supersededLines(0), loadedSize(-1), loaded(false) {}
+
+    static StudentAccountStore& raw() {
+        static StudentAccountStore store;
+        return store;
+    }
+
+    static StudentAccountStore& instance() {
+        StudentAccountStore& store = raw();
+        store.ensureLoaded();
+        return store;
+    }
+
+    static string toHex(const string& data) {
+        static const char digits[] = "0123456789abcdef";
+        string hex;
+        hex.reserve(data.size() * 2);
+        for (unsigned char c : data) {
+            hex += digits[c >> 4];
+            hex += digits[c & 0x0F];
+        }
+        return hex;
+    }
+
+    static string fromHex(string_view hex) {
+        string data;
+        data.reserve(hex.size() / 2);
+        for (size_t i = 0; i + 1 < hex.size(); i += 2) {
+            unsigned value = 0;
+            from_chars(hex.data() + i, hex.data() + i + 2, value, 16);
+            data += static_cast<char>(value);
+        }
+        return data;
+    }
+
+    static string lineOf(const StudentAccount& account) {
+        return account.username + "|" + toHex(account.password) + "|" +
+               account.rollNo + "|" + account.name + "\n";
+    }
+
+    // Converts the old four-lines-per-account credentials file, once
+    static void migrateLegacyFile() {
+        if (getFileSize(STUDENT_ACCOUNTS_FILE) >= 0) return;
+
+        ifstream legacy(STUDENT_CREDENTIALS_FILE);
+        if (!legacy) return;
+
+        string contents;
+        StudentAccount account;
+        while (getline(legacy, account.username) && getline(legacy, account.password) &&
+               getline(legacy, account.rollNo) && getline(legacy, account.name)) {
+            contents += lineOf(account);
+        }
+        legacy.close();
+
+        writeFileAtomically(STUDENT_ACCOUNTS_FILE, contents);
+    }
+
+    void ensureLoaded() {
+        if (!loaded) migrateLegacyFile();
+
+        streamoff size = getFileSize(STUDENT_ACCOUNTS_FILE);
+        if (loaded && size == loadedSize) return;
+
+        accounts.clear();
+        byUsername.clear();
+        byRollNo.clear();
+        supersededLines = 0;
+
+        MappedFile file(STUDENT_ACCOUNTS_FILE);
+        RecordReader reader(file);
+        vector<string_view> fields;
+        while (reader.next(fields)) {
+            if (fields.size() < 4) continue;
+
+            StudentAccount account;
+            account.username = string(fields[0]);
+            account.password = fromHex(fields[1]);
+            account.rollNo = string(fields[2]);
+            account.name = string(fields[3]);
+            index(account);
+        }
+
+        loadedSize = size;
+        loaded = true;
+    }
+
+    void index(const StudentAccount& account) {
+        auto it = byUsername.find(account.username);
+        if (it != byUsername.end()) {
+            accounts[it->second] = account;
+            supersededLines++;
+            return;
+        }
+
+        byUsername[account.username] = accounts.size();
+        byRollNo[account.rollNo] = accounts.size();
+        accounts.push_back(account);
+    }
+
+    bool append(const StudentAccount& account) {
+        if (!appendDurably(STUDENT_ACCOUNTS_FILE, lineOf(account))) return false;
+        index(account);
+
+        // Fold superseded lines away once they make up half the file
+        if (supersededLines >= 32 && supersededLines >= accounts.size()) {
+            string contents;
+            for (const auto& current : accounts) contents += lineOf(current);
+            if (writeFileAtomically(STUDENT_ACCOUNTS_FILE, contents)) supersededLines = 0;
+        }
+
+        loadedSize = getFileSize(STUDENT_ACCOUNTS_FILE);
+        return true;
+    }
+
+public:
+    // Looks the username up and checks the plain-text password against it
+    static bool authenticate(const string& username, const string& plainPassword, StudentAccount& account) {
+        const StudentAccountStore& store = instance();
+        auto it = store.byUsername.find(username);
+        if (it == store.byUsername.end()) return false;
+
+        const StudentAccount& stored = store.accounts[it->second];
+        if (encryptDecrypt(stored.password) != plainPassword) return false;
+
+        account = stored;
+        return true;
+    }
+
+    static bool usernameTaken(const string& username) {
+        return instance().byUsername.count(username) > 0;
+    }
+
+    static bool hasAccountFor(const string& rollNo) {
+        return instance().byRollNo.count(rollNo) > 0;
+    }
+
+    static size_t count() {
+        return instance().accounts.size();
+    }
+
+    static bool create(const StudentAccount& account) {
+        StudentAccountStore& store = instance();
+        if (store.byUsername.count(account.username) || store.byRollNo.count(account.rollNo)) return false;
+        return store.append(account);
+    }
+
+    static bool updatePassword(const string& username, const string& encryptedPassword) {
+        StudentAccountStore& store = instance();
+        auto it = store.byUsername.find(username);
+        if (it == store.byUsername.end()) return false;
+
+        StudentAccount account = store.accounts[it->second];
+        account.password = encryptedPassword;
+        return store.append(account);
+    }
+
+    // Warm start image: the current account of every username, plus the superseded line count
+    static void saveWarmStart(BinaryWriter& writer) {
+        const StudentAccountStore& store = instance();
+        writer.write<uint32_t>(static_cast<uint32_t>(store.supersededLines));
+        writer.write<uint32_t>(static_cast<uint32_t>(store.accounts.size()));
+        for (const auto& account : store.accounts) {
+            writer.writeString(account.username);
+            writer.writeString(account.password);
+            writer.writeString(account.rollNo);
+            writer.writeString(account.name);
+        }
+    }
+
+    static bool loadWarmStart(BinaryReader& reader) {
+        // Without the accounts file the legacy credentials may still need migrating
+        streamoff size = getFileSize(STUDENT_ACCOUNTS_FILE);
+        if (size < 0) return false;
+
+        size_t superseded = reader.read<uint32_t>();
+        uint32_t count = reader.read<uint32_t>();
+        vector<StudentAccount> accounts;
+        for (uint32_t i = 0; i < count && reader.ok(); i++) {
+            StudentAccount account;
+            account.username = reader.readString();
+            account.password = reader.readString();
+            account.rollNo = reader.readString();
+            account.name = reader.readString();
+            accounts.push_back(account);
+        }
+        if (!reader.ok()) return false;
+
+        StudentAccountStore& store = raw();
+        store.accounts.clear();
+        store.byUsername.clear();
+        store.byRollNo.clear();
+        for (const auto& account : accounts) store.index(account);
+        store.supersededLines = superseded;
+        store.loadedSize = size;
+        store.loaded = true;
+        return true;
+    }
+};
+
+// Exam Result Class
+class ExamResult {
+private:
+    string rollNo;
+    string semester;
+    string subject;
+    double marks;
+    string grade;
+    string examType;
+
+public:
+    ExamResult() : rollNo(""), semester(""), subject(""), marks(0.0), grade(""), examType("") {}
+    ExamResult(string r, string s, string sub, double m, string g, string et) 
+        : rollNo(r), semester(s), subject(sub), marks(m), grade(g), examType(et) {}
+
+    string getRollNo() const { return rollNo; }
+    string getSemester() const { return semester; }
+    string getSubject() const { return subject; }
+    double getMarks() const { return marks; }
+    string getGrade() const { return grade; }
+    string getExamType() const { return examType; }
+
+    void saveToFile(ostream& file) const {
+        file << rollNo << "|" << semester << "|" << subject << "|" 
+             << fixed << setprecision(2) << marks << "|" << grade << "|" << examType << endl;
+    }
+
+    void loadFromFields(const vector<string_view>& fields) {
+        rollNo = string(fieldAt(fields, 0));
+        semester = string(fieldAt(fields, 1));
+        subject = string(fieldAt(fields, 2));
+        marks = parseNumber(fieldAt(fields, 3), 0.0);
+        grade = string(fieldAt(fields, 4));
+        examType = string(fieldAt(fields, 5));
+    }
+
+    static string calculateGrade(double marks) {
+        if (marks >= 90) return "A+";
+        else if (marks >= 80) return "A";
+        else if (marks >= 70) return "B+";
+        else if (marks >= 60) return "B";
+        else if (marks >= 50) return "C";
+        else if (marks >= 40) return "D";
+        else return "F";
+    }
+};
+
+// Exam Result Index Class
+// Exam results grouped by roll number. exam_results.txt only grows by appends, so
+// a larger file is caught up by parsing just the new complete lines; a file that
+// shrank is parsed again from the start.
+class ExamResultIndex {
+private:
+    unordered_map<string, vector<ExamResult>> byRoll;
+    size_t resultCount;
+    streamoff loadedSize;
+    bool loaded;
+
+    ExamResultIndex() : resultCount(0), loadedSize(0), loaded(false) {}
+
+    static ExamResultIndex& raw() {
+        static ExamResultIndex index;
+        return index;
+    }
+
+    static ExamResultIndex& instance() {
+        ExamResultIndex& index = raw();
+        index.update();
+        return index;
+    }
+
+    void add(const ExamResult& result) {
+        byRoll[result.getRollNo()].push_back(result);
+        resultCount++;
+    }
+
+    void update() {
+        streamoff size = getFileSize(EXAM_RESULTS_FILE);
+        if (loaded && size == loadedSize) return;
+        if (!loaded || size < loadedSize) {
+            byRoll.clear();
+            resultCount = 0;
+            loadedSize = 0;
+            loaded = true;
+        }
+        if (size <= loadedSize) {
+            loadedSize = max<streamoff>(size, 0);
+            return;
+        }
+
+        MappedFile file(EXAM_RESULTS_FILE);
+        if (file.size() <= static_cast<size_t>(loadedSize)) return;
+
+        // A line still being written is left for the next call
+        const char* start = file.begin() + loadedSize;
+        size_t available = file.size() - static_cast<size_t>(loadedSize);
+        while (available > 0 && start[available - 1] != '\n') available--;
+
+        RecordReader reader(start, available);
+        vector<string_view> fields;
+        while (reader.next(fields)) {
+            ExamResult result;
+            result.loadFromFields(fields);
+            add(result);
+        }
+        loadedSize += static_cast<streamoff>(available);
+    }
+
+public:
+    // Results of one student in the order they were recorded
+    static vector<ExamResult> forStudent(const string& rollNo) {
+        const ExamResultIndex& index = instance();
+        auto it = index.byRoll.find(rollNo);
+        if (it == index.byRoll.end()) return vector<ExamResult>();
+        PerfCounters::add(PerfCounters::RECORDS_MATCHED, it->second.size());
+        return it->second;
+    }
+
+    // Warm start image: every result, grouped by student, and the file bytes covered
+    static void saveWarmStart(BinaryWriter& writer) {
+        const ExamResultIndex& index = instance();
+        writer.write<int64_t>(index.loadedSize);
+        writer.write<uint32_t>(static_cast<uint32_t>(index.resultCount));
+        for (const auto& entry : index.byRoll) {
+            for (const auto& result : entry.second) {
+                writer.writeString(result.getRollNo());
+                writer.writeString(result.getSemester());
+                writer.writeString(result.getSubject());
+                writer.write<double>(result.getMarks());
+                writer.writeString(result.getGrade());
+                writer.writeString(result.getExamType());
+            }
+        }
+    }
+
+    static bool loadWarmStart(BinaryReader& reader) {
+        streamoff covered = reader.read<int64_t>();
+        uint32_t count = reader.read<uint32_t>();
+        vector<ExamResult> results;
+        for (uint32_t i = 0; i < count && reader.ok(); i++) {
+            string rollNo = reader.readString();
+            string semester = reader.readString();
+            string subject = reader.readString();
+            double marks = reader.read<double>();
+            string grade = reader.readString();
+            string examType = reader.readString();
+            results.emplace_back(rollNo, semester, subject, marks, grade, examType);
+        }
+        if (!reader.ok() || covered < 0) return false;
+
+        ExamResultIndex& index = raw();
+        index.byRoll.clear();
+        index.resultCount = 0;
+        for (const auto& result : results) index.add(result);
+        index.loadedSize = covered;
+        index.loaded = true;
+        return true;
+    }
+};
+
+// Attendance Class
+class Attendance {
+private:
+    string rollNo;
+    string date;
+    string status;
+    string subject;
+
+public:
+    Attendance() : rollNo(""), date(""), status(""), subject("") {}
+    Attendance(string r, string d, string s, string sub = "") 
+        : rollNo(r), date(d), status(s), subject(sub) {}
+
+    string getRollNo() const { return rollNo; }
+    string getDate() const { return date; }
+    string getStatus() const { return status; }
+    string getSubject() const { return subject; }
+
+    void setRollNo(const string& r) { rollNo = r; }
+    void setDate(const string& d) { date = d; }
+    void setStatus(const string& s) { status = s; }
+    void setSubject(const string& sub) { subject = sub; }
+
+    void saveToFile(ofstream& file) const {
+        file << rollNo << "|" << date << "|" << status << "|" << subject << endl;
+    }
+
+    void loadFromFields(const vector<string_view>& fields) {
+        rollNo = string(fieldAt(fields, 0));
+        date = string(fieldAt(fields, 1));
+        status = string(fieldAt(fields, 2));
+        subject = string(fieldAt(fields, 3));
+    }
+
+    // Served from AttendanceIndex (defined below)
+    static double calculateAttendancePercentage(const string& rollNo, const string& subject = "");
+
+    // Served from the sorted class-day dictionary in AttendanceIndex
+    static vector<string> getAvailableDates();
+
+    static vector<string> getSubjectsForStudent(const string& rollNo);
+};
+
+// Attendance Columns - in-memory column arrays of the attendance store
+// Roll numbers and subjects are dictionary encoded (subject id 0 = no subject),
+// dates are day numbers and statuses are packed one bit per record (1 = present).
+struct AttendanceColumns {
+    vector<string> rollDict;
+    vector<string> subjectDict;
+    unordered_map<string, uint32_t> rollIds;
+    unordered_map<string, uint16_t> subjectIds;
+
+    vector<uint32_t> rolls;
+    vector<int32_t> days;
+    vector<uint16_t> subjects;
+    vector<uint64_t> statusBits;
+
+    AttendanceColumns() { clear(); }
+
+    void clear() {
+        rollDict.clear();
+        rollIds.clear();
+        subjectDict.assign(1, "");
+        subjectIds.clear();
+        rolls.clear();
+        days.clear();
+        subjects.clear();
+        statusBits.clear();
+    }
+
+    size_t size() const { return rolls.size(); }
+
+    bool isPresent(size_t i) const { return (statusBits[i >> 6] >> (i & 63)) & 1; }
+
+    // Dictionary id of a roll number, added if new
+    uint32_t internRoll(const string& roll) {
+        auto it = rollIds.emplace(roll, static_cast<uint32_t>(rollDict.size()));
+        if (it.second) rollDict.push_back(roll);
+        return it.first->second;
+    }
+
+    // Dictionary id of a subject, added if new; false once the 16-bit ids run out
+    bool internSubject(const string& subject, uint16_t& id) {
+        if (subject.empty()) {
+            id = 0;
+            return true;
+        }
+        auto it = subjectIds.find(subject);
+        if (it == subjectIds.end()) {
+            if (subjectDict.size() > UINT16_MAX) return false;
+            it = subjectIds.emplace(subject, static_cast<uint16_t>(subjectDict.size())).first;
+            subjectDict.push_back(subject);
+        }
+        id = it->second;
+        return true;
+    }
+
+    const string& rollAt(size_t i) const { return rollDict[rolls[i]]; }
+    const string& subjectAt(size_t i) const { return subjectDict[subjects[i]]; }
+
+    Attendance record(size_t i) const {
+        return Attendance(rollAt(i), daysToDate(days[i]), isPresent(i) ? "P" : "A", subjectAt(i));
+    }
+
+    void push(uint32_t roll, int32_t day, uint16_t subject, bool present) {
+        size_t i = rolls.size();
+        if ((i & 63) == 0) statusBits.push_back(0);
+        if (present) statusBits[i >> 6] |= uint64_t(1) << (i & 63);
+        rolls.push_back(roll);
+        days.push_back(day);
+        subjects.push_back(subject);
+    }
+};
+
+// Attendance Counter - total/present tally for one student (optionally one subject)
+struct AttendanceCounter {
+    int total;
+    int present;
+
+    AttendanceCounter() : total(0), present(0) {}
+};
+
+// Attendance Counter File Class
+// attendance/counters.dat holds each student's present/total counts, overall and per
+// subject, so the student portal answers from one small read instead of loading the
+// store. The file names the manifest prefix it covers (its length and a CRC-32 of its
+// last 4 KB). Each commit appends its records to counters.log as a delta from the
+// manifest prefix before it to the one after it, and a lookup adds the deltas that lead
+// from the file's prefix to the current manifest; once they outgrow a quarter of the
+// file they are folded into it. A missing, damaged or stale file is rebuilt from the
+// attendance index, that is from the segments themselves.
+// Layout: an 8-byte magic, a CRC-32 of the header, the covered stamp, the subject
+// dictionary and an offset table, then one entry per roll number in sorted order, each
+// with its own CRC-32 so that a lookup checks only what it reads. counters.log is a run
+// of [magic][length][crc32][payload] blocks, one per commit.
+class AttendanceCounterFile {
+public:
+    struct Summary {
+        AttendanceCounter overall;
+        vector<pair<string, AttendanceCounter>> subjects;      // first-seen order
+    };
+
+private:
+    static constexpr char FILE_MAGIC[9] = "SAMCNT01";
+    static constexpr uint32_t DELTA_MAGIC = 0x544C4443;     // "CDLT"
+    static const size_t TAIL_BYTES = 4096;
+
+    struct Stamp {
+        int64_t size;
+        uint32_t tailCrc;
+
+        bool operator==(const Stamp& other) const { return size == other.size && tailCrc == other.tailCrc; }
+    };
+
+    struct Entry {
+        string rollNo;
+        vector<pair<uint16_t, AttendanceCounter>> counters;    // subject id 0 (overall) first
+    };
+
+    struct Contents {
+        Stamp stamp;
+        vector<string> subjects;                                // id 0 = overall
+        vector<Entry> entries;                                  // sorted by roll number
+    };
+
+    // One commit's records and the manifest prefixes before and after it
+    struct Delta {
+        Stamp before;
+        Stamp after;
+        vector<Attendance> records;
+    };
+
+    // Stamp of the first size bytes of the manifest; false if it is shorter than that
+    static bool stampAt(streamoff size, Stamp& stamp) {
+        if (size < 0) return false;
+        MappedFile manifest(ATTENDANCE_MANIFEST_FILE);
+        if (!manifest.isOpen() || static_cast<streamoff>(manifest.size()) < size) return false;
+        size_t tail = min<size_t>(TAIL_BYTES, static_cast<size_t>(size));
+        stamp.size = size;
+        stamp.tailCrc = size > 0 ? crc32(manifest.begin() + size - tail, tail) : 0;
+        return true;
+    }
+
+    static bool currentStamp(Stamp& stamp) {
+        return stampAt(getFileSize(ATTENDANCE_MANIFEST_FILE), stamp);
+    }
+
+    static string encode(const Contents& contents) {
+        string entries;
+        vector<uint32_t> offsets;
+        for (const auto& entry : contents.entries) {
+            string body;
+            BinaryWriter writer(body);
+            writer.writeString(entry.rollNo);
+            writer.write<uint16_t>(static_cast<uint16_t>(entry.counters.size()));
+            for (const auto& counter : entry.counters) {
+                writer.write<uint16_t>(counter.first);
+                writer.write<int32_t>(counter.second.total);
+                writer.write<int32_t>(counter.second.present);
+            }
+            offsets.push_back(static_cast<uint32_t>(entries.size()));
+            BinaryWriter(entries).write<uint32_t>(crc32(body.data(), body.size()));
+            entries += body;
+        }
+
+        string header;
+        BinaryWriter writer(header);
+        writer.write<int64_t>(contents.stamp.size);
+        writer.write<uint32_t>(contents.stamp.tailCrc);
+        writer.write<uint32_t>(static_cast<uint32_t>(contents.subjects.size()));
+        for (size_t i = 1; i < contents.subjects.size(); i++) writer.writeString(contents.subjects[i]);
+        writer.write<uint32_t>(static_cast<uint32_t>(offsets.size()));
+        size_t entriesStart = sizeof(FILE_MAGIC) - 1 + sizeof(uint32_t) + header.size() + offsets.size() * sizeof(uint32_t);
+        for (uint32_t& offset : offsets) offset += static_cast<uint32_t>(entriesStart);
+        writer.writeArray(offsets);
+
+        string file(FILE_MAGIC, sizeof(FILE_MAGIC) - 1);
+        BinaryWriter(file).write<uint32_t>(crc32(header.data(), header.size()));
+        return file + header + entries;
+    }
+
+    // Header fields and entry offsets of a mapped counter file; false if it is not one
+    static bool readHeader(const MappedFile& file, Contents& contents, vector<uint32_t>& offsets) {
+        const size_t magicBytes = sizeof(FILE_MAGIC) - 1;
+        if (file.size() < magicBytes + sizeof(uint32_t) || memcmp(file.begin(), FILE_MAGIC, magicBytes) != 0) return false;
+
+        BinaryReader reader(file.begin() + magicBytes, file.size() - magicBytes);
+        uint32_t crc = reader.read<uint32_t>();
+        size_t headerStart = reader.position();
+        contents.stamp.size = reader.read<int64_t>();
+        contents.stamp.tailCrc = reader.read<uint32_t>();
+        uint32_t subjects = reader.read<uint32_t>();
+        contents.subjects.assign(1, "");
+        for (uint32_t i = 1; i < subjects && reader.ok(); i++) contents.subjects.push_back(reader.readString());
+        reader.readArray(offsets, reader.read<uint32_t>());
+        if (!reader.ok()) return false;
+
+        const char* header = file.begin() + magicBytes + headerStart;
+        if (crc32(header, reader.position() - headerStart) != crc) return false;
+        for (uint32_t offset : offsets) {
+            if (offset >= file.size()) return false;
+        }
+        return true;
+    }
+
+    // The entry at offset; false if it fails its CRC
+    static bool readEntry(const MappedFile& file, uint32_t offset, Entry& entry) {
+        BinaryReader reader(file.begin() + offset, file.size() - offset);
+        uint32_t crc = reader.read<uint32_t>();
+        entry.rollNo = reader.readString();
+        uint16_t count = reader.read<uint16_t>();
+        entry.counters.clear();
+        for (uint16_t i = 0; i < count && reader.ok(); i++) {
+            uint16_t subject = reader.read<uint16_t>();
+            AttendanceCounter counter;
+            counter.total = reader.read<int32_t>();
+            counter.present = reader.read<int32_t>();
+            entry.counters.push_back({subject, counter});
+        }
+        return reader.ok() && crc32(file.begin() + offset + sizeof(uint32_t), reader.position() - sizeof(uint32_t)) == crc;
+    }
+
+    static string_view rollAt(const MappedFile& file, uint32_t offset) {
+        BinaryReader reader(file.begin() + offset, file.size() - offset);
+        reader.skip(sizeof(uint32_t));
+        uint16_t length = reader.read<uint16_t>();
+        if (!reader.ok() || file.size() - offset - reader.position() < length) return string_view();
+        return string_view(file.begin() + offset + reader.position(), length);
+    }
+
+    static bool load(Contents& contents) {
+        MappedFile file(ATTENDANCE_COUNTERS_FILE);
+        vector<uint32_t> offsets;
+        if (!file.isOpen() || !readHeader(file, contents, offsets)) return false;
+
+        contents.entries.resize(offsets.size());
+        for (size_t i = 0; i < offsets.size(); i++) {
+            if (!readEntry(file, offsets[i], contents.entries[i])) return false;
+        }
+        return true;
+    }
+
+    static string encodeDelta(const Stamp& before, const Stamp& after, const vector<Attendance>& records) {
+        string payload;
+        BinaryWriter writer(payload);
+        writer.write<int64_t>(before.size);
+        writer.write<uint32_t>(before.tailCrc);
+        writer.write<int64_t>(after.size);
+        writer.write<uint32_t>(after.tailCrc);
+        writer.write<uint32_t>(static_cast<uint32_t>(records.size()));
+        for (const auto& record : records) {
+            writer.writeString(record.getRollNo());
+            writer.writeString(record.getDate());
+            writer.writeString(record.getStatus());
+            writer.writeString(record.getSubject());
+        }
+
+        string block;
+        BinaryWriter header(block);
+        header.write<uint32_t>(DELTA_MAGIC);
+        header.write<uint32_t>(static_cast<uint32_t>(payload.size()));
+        header.write<uint32_t>(crc32(payload.data(), payload.size()));
+        return block + payload;
+    }
+
+    // The deltas in counters.log, keeping only one student's records unless rollNo is
+    // null. Reading stops at the first damaged block, e.g. an append cut short.
+    static vector<Delta> loadDeltas(const string* rollNo) {
+        vector<Delta> deltas;
+        MappedFile file(ATTENDANCE_COUNTER_DELTAS_FILE);
+        if (!file.isOpen()) return deltas;
+
+        BinaryReader blocks(file.begin(), file.size());
+        while (blocks.position() < file.size()) {
+            uint32_t magic = blocks.read<uint32_t>();
+            uint32_t length = blocks.read<uint32_t>();
+            uint32_t crc = blocks.read<uint32_t>();
+            size_t start = blocks.position();
+            if (!blocks.ok() || magic != DELTA_MAGIC || file.size() - start < length) break;
+            if (crc32(file.begin() + start, length) != crc) break;
+            blocks.skip(length);
+
+            BinaryReader reader(file.begin() + start, length);
+            Delta delta;
+            delta.before.size = reader.read<int64_t>();
+            delta.before.tailCrc = reader.read<uint32_t>();
+            delta.after.size = reader.read<int64_t>();
+            delta.after.tailCrc = reader.read<uint32_t>();
+            uint32_t count = reader.read<uint32_t>();
+            for (uint32_t i = 0; i < count && reader.ok(); i++) {
+                string roll = reader.readString();
+                string date = reader.readString();
+                string status = reader.readString();
+                string subject = reader.readString();
+                if (!rollNo || roll == *rollNo) delta.records.push_back(Attendance(roll, date, status, subject));
+            }
+            if (!reader.ok()) break;
+            deltas.push_back(move(delta));
+        }
+        return deltas;
+    }
+
+    // Adds committed records to the counters; false if the subject ids run out. Records
+    // go in month by month, the order the store keeps them in, so that subjects are
+    // listed in the same first-seen order as the index lists them.
+    static bool merge(Contents& contents, const vector<Attendance>& records) {
+        unordered_map<string, uint16_t> subjectIds;
+        for (size_t i = 1; i < contents.subjects.size(); i++) subjectIds[contents.subjects[i]] = static_cast<uint16_t>(i);
+
+        vector<const Attendance*> ordered;
+        for (const auto& record : records) ordered.push_back(&record);
+        stable_sort(ordered.begin(), ordered.end(), [](const Attendance* a, const Attendance* b) {
+            return a->getDate().compare(0, 7, b->getDate(), 0, 7) < 0;
+        });
+
+        map<string, Entry> added;
+        for (const Attendance* next : ordered) {
+            const Attendance& record = *next;
+            const string& rollNo = record.getRollNo();
+            auto it = lower_bound(contents.entries.begin(), contents.entries.end(), rollNo,
+                                  [](const Entry& entry, const string& roll) { return entry.rollNo < roll; });
+            Entry* entry = it != contents.entries.end() && it->rollNo == rollNo ? &*it : &added[rollNo];
+            if (entry->counters.empty()) {
+                entry->rollNo = rollNo;
+                entry->counters.push_back({0, AttendanceCounter()});
+            }
+
+            uint16_t subject = 0;
+            if (!record.getSubject().empty()) {
+                auto id = subjectIds.find(record.getSubject());
+                if (id == subjectIds.end()) {
+                    if (contents.subjects.size() > UINT16_MAX) return false;
+                    id = subjectIds.emplace(record.getSubject(), static_cast<uint16_t>(contents.subjects.size())).first;
+                    contents.subjects.push_back(record.getSubject());
+                }
+                subject = id->second;
+            }
+
+            bool present = record.getStatus() == "P";
+            for (auto& counter : entry->counters) {
+                if (counter.first != 0 && counter.first != subject) continue;
+                counter.second.total++;
+                if (present) counter.second.present++;
+            }
+            if (subject != 0 && find_if(entry->counters.begin(), entry->counters.end(),
+                                        [&](const pair<uint16_t, AttendanceCounter>& counter) { return counter.first == subject; })
+                                == entry->counters.end()) {
+                AttendanceCounter counter;
+                counter.total = 1;
+                counter.present = present ? 1 : 0;
+                entry->counters.push_back({subject, counter});
+            }
+        }
+
+        if (!added.empty()) {
+            vector<Entry> entries;
+            entries.reserve(contents.entries.size() + added.size());
+            auto next = added.begin();
+            for (auto& entry : contents.entries) {
+                for (; next != added.end() && next->first < entry.rollNo; ++next) entries.push_back(move(next->second));
+                entries.push_back(move(entry));
+            }
+            for (; next != added.end(); ++next) entries.push_back(move(next->second));
+            contents.entries.swap(entries);
+        }
+        return true;
+    }
+
+    // Merges the deltas that lead from the contents' stamp to target, in whatever order
+    // concurrent commits appended them; false if they do not get there
+    static bool applyDeltas(Contents& contents, const vector<Delta>& deltas, const Stamp& target) {
+        vector<bool> used(deltas.size(), false);
+        while (!(contents.stamp == target)) {
+            size_t next = 0;
+            while (next < deltas.size() && (used[next] || !(deltas[next].before == contents.stamp))) next++;
+            if (next == deltas.size() || !merge(contents, deltas[next].records)) return false;
+            used[next] = true;
+            contents.stamp = deltas[next].after;
+        }
+        return true;
+    }
+
+    // Finds one student in a valid file, adding the deltas since it was written; false
+    // if the file and deltas together do not cover the current manifest
+    static bool lookup(const string& rollNo, Summary& summary) {
+        Stamp stamp;
+        if (!currentStamp(stamp)) return false;
+
+        MappedFile file(ATTENDANCE_COUNTERS_FILE);
+        Contents contents;
+        vector<uint32_t> offsets;
+        if (!file.isOpen() || !readHeader(file, contents, offsets)) return false;
+
+        size_t low = 0, high = offsets.size();
+        while (low < high) {
+            size_t mid = (low + high) / 2;
+            if (rollAt(file, offsets[mid]) < rollNo) low = mid + 1;
+            else high = mid;
+        }
+        if (low < offsets.size() && rollAt(file, offsets[low]) == rollNo) {
+            Entry entry;
+            if (!readEntry(file, offsets[low], entry) || entry.rollNo != rollNo) return false;
+            contents.entries.push_back(move(entry));
+        }
+        if (!(contents.stamp == stamp) && !applyDeltas(contents, loadDeltas(&rollNo), stamp)) return false;
+
+        summary = Summary();
+        for (const auto& entry : contents.entries) {
+            for (const auto& counter : entry.counters) {
+                if (counter.first >= contents.subjects.size()) return false;
+                if (counter.first == 0) summary.overall = counter.second;
+                else summary.subjects.push_back({contents.subjects[counter.first], counter.second});
+            }
+        }
+        return true;
+    }
+
+    // Writes the file with every delta merged in and drops counters.log; false if the
+    // deltas do not reach the current manifest
+    static bool fold() {
+        Stamp stamp;
+        Contents contents;
+        if (!currentStamp(stamp) || !load(contents)) return false;
+        if (!applyDeltas(contents, loadDeltas(nullptr), stamp)) return false;
+        if (!writeFileAtomically(ATTENDANCE_COUNTERS_FILE, encode(contents))) return false;
+
+        error_code ec;
+        filesystem::remove(ATTENDANCE_COUNTER_DELTAS_FILE, ec);
+        return true;
+    }
+
+public:
+    // Records the commit that took the manifest from its first before bytes to its first
+    // after bytes as one delta block. It is not synced: a lost or torn delta only means
+    // the file is rebuilt on next use.
+    static void advance(streamoff before, streamoff after, const vector<Attendance>& records) {
+        // Without a file there is nothing to carry forward; the next lookup builds one
+        if (getFileSize(ATTENDANCE_COUNTERS_FILE) < 0) return;
+
+        Stamp from, to;
+        if (!stampAt(before, from) || !stampAt(after, to)) return;
+        ofstream file(ATTENDANCE_COUNTER_DELTAS_FILE, ios::binary | ios::app);
+        string block = encodeDelta(from, to, records);
+        file.write(block.data(), static_cast<streamsize>(block.size()));
+    }
+
+    // Folds the deltas into the file, or failing that rewrites it from the attendance
+    // index; false if the store moved on meanwhile or the file could not be written
+    static bool rebuild();
+
+    // Overall and per-subject counters of one student, from the file when it is current,
+    // else from the index after rebuilding the file
+    static Summary forStudent(const string& rollNo);
+};
+
+// Attendance Store Class
+// Attendance is partitioned by month. attendance/YYYY-MM.dat holds the records dated
+// in that month: an 8-byte file header followed by blocks, each [magic][payload
+// length][crc32] and a payload holding the dictionary entries first seen in the
+// segment followed by the roll/day/subject/status columns of its records.
+// attendance/manifest.txt is append-only with one line per commit, listing every
+// segment the commit touched with its dates, record count and committed size:
+//     2024-03|2024-03-01|2024-03-28|5120|81234;2024-04|2024-04-01|2024-04-02|640|10377
+// Segment bytes past the last committed size are an unfinished commit and are never
+// read, so a commit becomes visible with one manifest write. getColumns() replays the
+// manifest, so records come back in commit order (month by month within a commit);
+// readRange() opens only the segments whose dates overlap. An older single-file
+// attendance.dat, or else attendance.txt, is split into segments once on first use.
+class AttendanceStore {
+private:
+    static constexpr char FILE_MAGIC[9] = "SAMATT01";
+    static constexpr uint32_t LEGACY_BLOCK_MAGIC = 0x4B4C4241;  // "ABLK": [magic][length][payload]
+    static constexpr uint32_t BLOCK_MAGIC = 0x324C4241;         // "ABL2": [magic][length][crc32][payload]
+
+    // Segment dictionary ids -> ids in the columns the segment is decoded into
+    struct SegmentCursor {
+        vector<uint32_t> rolls;
+        vector<uint16_t> subjects;
+
+        SegmentCursor() : subjects(1, 0) {}
+    };
+
+    // A segment as of the latest manifest entry naming it
+    struct SegmentInfo {
+        int firstDay = INT_MAX;
+        int lastDay = INT_MIN;
+        uint64_t records = 0;
+        streamoff bytes = 0;
+    };
+
+    struct Segment {
+        SegmentInfo info;
+        streamoff loadedBytes = 0;      // how much of it getColumns() has decoded
+        SegmentCursor cursor;
+    };
+
+    // One manifest entry: the committed size of a segment after some commit
+    struct Commit {
+        string month;
+        streamoff bytes;
+    };
+
+    map<string, Segment> segments;
+    vector<Commit> commits;
+    size_t viewedCommits;
+    streamoff manifestBytes;
+    AttendanceColumns columns;
+    bool loaded;
+    unsigned long generation;
+
+    AttendanceStore() : viewedCommits(0), manifestBytes(0), loaded(false), generation(0) {}
+
+    static AttendanceStore& instance() {
+        static AttendanceStore store;
+        return store;
+    }
+
+    static string segmentPath(const string& month) {
+        return ATTENDANCE_SEGMENT_DIR + "/" + month + ".dat";
+    }
+
+    // Decodes one block payload; columns are only touched once the whole block checked out
+    static bool decodeBlock(const char* data, size_t size, AttendanceColumns& target, SegmentCursor& cursor) {
+        BinaryReader reader(data, size);
+        uint32_t count = reader.read<uint32_t>();
+
+        vector<string> newRolls, newSubjects;
+        uint32_t rollCount = reader.read<uint32_t>();
+        for (uint32_t i = 0; i < rollCount && reader.ok(); i++) newRolls.push_back(reader.readString());
+        uint32_t subjectCount = reader.read<uint32_t>();
+        for (uint32_t i = 0; i < subjectCount && reader.ok(); i++) newSubjects.push_back(reader.readString());
+
+        vector<uint32_t> rolls;
+        vector<int32_t> days;
+        vector<uint16_t> subjects;
+        vector<uint64_t> bits;
+        reader.readArray(rolls, count);
+        reader.readArray(days, count);
+        reader.readArray(subjects, count);
+        reader.readArray(bits, (count + 63) / 64);
+        if (!reader.ok() || reader.position() != size) return false;
+
+        size_t rollLimit = cursor.rolls.size() + newRolls.size();
+        size_t subjectLimit = cursor.subjects.size() + newSubjects.size();
+        for (uint32_t i = 0; i < count; i++) {
+            if (rolls[i] >= rollLimit || subjects[i] >= subjectLimit) return false;
+        }
+        if (target.subjectDict.size() + newSubjects.size() > size_t(UINT16_MAX) + 1) return false;
+
+        for (const auto& roll : newRolls) cursor.rolls.push_back(target.internRoll(roll));
+        for (const auto& subject : newSubjects) {
+            uint16_t id = 0;
+            target.internSubject(subject, id);
+            cursor.subjects.push_back(id);
+        }
+        for (uint32_t i = 0; i < count; i++) {
+            target.push(cursor.rolls[rolls[i]], days[i], cursor.subjects[subjects[i]], (bits[i >> 6] >> (i & 63)) & 1);
+        }
+        PerfCounters::add(PerfCounters::RECORDS_PARSED, count);
+        return true;
+    }
+
+    // Parses every complete, intact block in the buffer and returns the bytes consumed.
+    // Decoding stops at the first torn or corrupt block (e.g. a write cut short by a crash).
+    static size_t decodeBlocks(const char* data, size_t size, AttendanceColumns& target, SegmentCursor& cursor) {
+        size_t pos = 0;
+        while (size - pos >= 8) {
+            uint32_t magic, length;
+            memcpy(&magic, data + pos, 4);
+            memcpy(&length, data + pos + 4, 4);
+            if (magic != BLOCK_MAGIC && magic != LEGACY_BLOCK_MAGIC) break;
+
+            size_t headerSize = magic == BLOCK_MAGIC ? 12 : 8;
+            if (size - pos < headerSize || size - pos - headerSize < length) break;
+            if (magic == BLOCK_MAGIC) {
+                uint32_t checksum;
+                memcpy(&checksum, data + pos + 8, 4);
+                if (crc32(data + pos + headerSize, length) != checksum) break;
+            }
+
+            if (!decodeBlock(data + pos + headerSize, length, target, cursor)) break;
+            pos += headerSize + length;
+        }
+        return pos;
+    }
+
+    // Decodes the blocks between two offsets of a segment file and returns the offset
+    // reached, which falls short of 'to' if the file is short or a block is damaged
+    static streamoff decodeSegment(const MappedFile& file, streamoff from, streamoff to,
+                                   AttendanceColumns& target, SegmentCursor& cursor) {
+        if (static_cast<streamoff>(file.size()) < to || to < 8) return from;
+        if (from == 0) {
+            if (memcmp(file.begin(), FILE_MAGIC, 8) != 0) return 0;
+            from = 8;
+        }
+        return from + static_cast<streamoff>(decodeBlocks(file.begin() + from, static_cast<size_t>(to - from), target, cursor));
+    }
+
+    // Frames one block: the new dictionary entries followed by the column arrays
+    static void writeBlock(const vector<string>& newRolls, const vector<string>& newSubjects,
+                           const vector<uint32_t>& rolls, const vector<int32_t>& days,
+                           const vector<uint16_t>& subjects, const vector<uint64_t>& bits, string& out) {
+        string payload;
+        BinaryWriter writer(payload);
+        writer.write<uint32_t>(static_cast<uint32_t>(rolls.size()));
+        writer.write<uint32_t>(static_cast<uint32_t>(newRolls.size()));
+        for (const auto& roll : newRolls) writer.writeString(roll);
+        writer.write<uint32_t>(static_cast<uint32_t>(newSubjects.size()));
+        for (const auto& subject : newSubjects) writer.writeString(subject);
+        writer.writeArray(rolls);
+        writer.writeArray(days);
+        writer.writeArray(subjects);
+        writer.writeArray(bits);
+
+        BinaryWriter header(out);
+        header.write<uint32_t>(BLOCK_MAGIC);
+        header.write<uint32_t>(static_cast<uint32_t>(payload.size()));
+        header.write<uint32_t>(crc32(payload.data(), payload.size()));
+        out += payload;
+    }
+
+    // Encodes records as one block; roll numbers and subjects missing from the
+    // dictionaries in 'known' are written as new dictionary entries
+    static bool encodeBlock(const vector<Attendance>& records, const AttendanceColumns& known, string& out) {
+        unordered_map<string, uint32_t> pendingRolls;
+        unordered_map<string, uint16_t> pendingSubjects;
+        vector<string> newRolls, newSubjects;
+        vector<uint32_t> rolls;
+        vector<int32_t> days;
+        vector<uint16_t> subjects;
+        vector<uint64_t> bits((records.size() + 63) / 64, 0);
+
+        for (size_t i = 0; i < records.size(); i++) {
+            const Attendance& record = records[i];
+            int day = dateToDays(record.getDate());
+            if (day == INVALID_DAY) return false;
+
+            uint32_t rollId;
+            auto roll = known.rollIds.find(record.getRollNo());
+            if (roll != known.rollIds.end()) {
+                rollId = roll->second;
+            } else {
+                auto pending = pendingRolls.emplace(record.getRollNo(),
+                    static_cast<uint32_t>(known.rollDict.size() + newRolls.size()));
+                if (pending.second) newRolls.push_back(record.getRollNo());
+                rollId = pending.first->second;
+            }
+
+            uint16_t subjectId = 0;
+            if (!record.getSubject().empty()) {
+                auto subject = known.subjectIds.find(record.getSubject());
+                if (subject != known.subjectIds.end()) {
+                    subjectId = subject->second;
+                } else {
+                    if (known.subjectDict.size() + newSubjects.size() > UINT16_MAX) return false;
+                    auto pending = pendingSubjects.emplace(record.getSubject(),
+                        static_cast<uint16_t>(known.subjectDict.size() + newSubjects.size()));
+                    if (pending.second) newSubjects.push_back(record.getSubject());
+                    subjectId = pending.first->second;
+                }
+            }
+
+            rolls.push_back(rollId);
+            days.push_back(day);
+            subjects.push_back(subjectId);
+            if (record.getStatus() == "P") bits[i >> 6] |= uint64_t(1) << (i & 63);
+        }
+
+        writeBlock(newRolls, newSubjects, rolls, days, subjects, bits, out);
+        return true;
+    }
+
+    // Encodes the given rows of 'source' as the first block of a new segment
+    static void encodeRows(const AttendanceColumns& source, const vector<size_t>& rows, string& out) {
+        vector<uint32_t> localRolls(source.rollDict.size(), UINT32_MAX);
+        vector<uint16_t> localSubjects(source.subjectDict.size(), UINT16_MAX);
+        localSubjects[0] = 0;
+        vector<string> newRolls, newSubjects;
+        vector<uint32_t> rolls(rows.size());
+        vector<int32_t> days(rows.size());
+        vector<uint16_t> subjects(rows.size());
+        vector<uint64_t> bits((rows.size() + 63) / 64, 0);
+
+        for (size_t k = 0; k < rows.size(); k++) {
+            size_t row = rows[k];
+            uint32_t& roll = localRolls[source.rolls[row]];
+            if (roll == UINT32_MAX) {
+                roll = static_cast<uint32_t>(newRolls.size());
+                newRolls.push_back(source.rollDict[source.rolls[row]]);
+            }
+            uint16_t& subject = localSubjects[source.subjects[row]];
+            if (subject == UINT16_MAX) {
+                subject = static_cast<uint16_t>(newSubjects.size() + 1);
+                newSubjects.push_back(source.subjectDict[source.subjects[row]]);
+            }
+
+            rolls[k] = roll;
+            days[k] = source.days[row];
+            subjects[k] = subject;
+            if (source.isPresent(row)) bits[k >> 6] |= uint64_t(1) << (k & 63);
+        }
+
+        writeBlock(newRolls, newSubjects, rolls, days, subjects, bits, out);
+    }
+
+    // Rebuilds a segment's dictionaries from the columns it was decoded into
+    void segmentDictionaries(const SegmentCursor& cursor, AttendanceColumns& known) const {
+        for (uint32_t roll : cursor.rolls) {
+            known.rollIds.emplace(columns.rollDict[roll], static_cast<uint32_t>(known.rollDict.size()));
+            known.rollDict.push_back(columns.rollDict[roll]);
+        }
+        for (size_t i = 1; i < cursor.subjects.size(); i++) {
+            known.subjectIds.emplace(columns.subjectDict[cursor.subjects[i]], static_cast<uint16_t>(i));
+            known.subjectDict.push_back(columns.subjectDict[cursor.subjects[i]]);
+        }
+    }
+
+    static string manifestEntry(const string& month, const SegmentInfo& info) {
+        return month + "|" + daysToDate(info.firstDay) + "|" + daysToDate(info.lastDay) + "|" +
+               to_string(info.records) + "|" + to_string(info.bytes);
+    }
+
+    // Applies one manifest line; a line that does not parse completely is ignored
+    void applyManifestLine(string_view line) {
+        vector<pair<string, SegmentInfo>> entries;
+        vector<string_view> fields;
+        while (!line.empty()) {
+            size_t end = min(line.find(';'), line.size());
+            RecordReader reader(line.data(), end);
+            line.remove_prefix(min(end + 1, line.size()));
+            if (!reader.next(fields) || fields.size() != 5 || fields[0].size() != 7) return;
+
+            SegmentInfo info;
+            info.firstDay = dateToDays(string(fields[1]));
+            info.lastDay = dateToDays(string(fields[2]));
+            info.records = parseNumber<uint64_t>(fields[3], 0);
+            info.bytes = parseNumber<int64_t>(fields[4], 0);
+            if (info.firstDay == INVALID_DAY || info.lastDay == INVALID_DAY || info.bytes < 8) return;
+            entries.emplace_back(string(fields[0]), info);
+        }
+
+        for (const auto& entry : entries) {
+            segments[entry.first].info = entry.second;
+            commits.push_back({entry.first, entry.second.bytes});
+        }
+    }
+
+    void reset() {
+        segments.clear();
+        commits.clear();
+        viewedCommits = 0;
+        manifestBytes = 0;
+        columns.clear();
+        generation++;
+    }
+
+    // Reads the manifest lines appended since the last call. A line still being written
+    // (no newline yet) is left for later.
+    void refresh() {
+        if (!loaded) {
+            if (getFileSize(ATTENDANCE_MANIFEST_FILE) < 0) migrate();
+            loaded = true;
+            reset();
+        }
+
+        streamoff size = getFileSize(ATTENDANCE_MANIFEST_FILE);
+        if (size < manifestBytes) reset();
+        // A torn tail is read again on every refresh rather than remembered by size: an
+        // append (here or in another process) cuts it off and may leave the same length
+        if (size <= manifestBytes) return;
+
+        ifstream file(ATTENDANCE_MANIFEST_FILE, ios::binary);
+        if (!file) return;
+        string buffer(static_cast<size_t>(size - manifestBytes), '\0');
+        file.seekg(manifestBytes);
+        file.read(&buffer[0], buffer.size());
+        buffer.resize(static_cast<size_t>(file.gcount()));
+        file.close();
+        PerfCounters::add(PerfCounters::FILES_OPENED);
+        PerfCounters::add(PerfCounters::BYTES_READ, buffer.size());
+
+        size_t pos = 0;
+        for (size_t end; (end = buffer.find('\n', pos)) != string::npos; pos = end + 1) {
+            string_view line(buffer.data() + pos, end - pos);
+            if (!line.empty() && line.back() == '\r') line.remove_suffix(1);
+            applyManifestLine(line);
+        }
+        manifestBytes += static_cast<streamoff>(pos);
+    }
+
+    // Brings the columns up to the latest commit, decoding each commit's bytes in manifest order
+    void updateColumns() {
+        refresh();
+
+        map<string, unique_ptr<MappedFile>> files;
+        for (; viewedCommits < commits.size(); viewedCommits++) {
+            const Commit& commit = commits[viewedCommits];
+            Segment& segment = segments[commit.month];
+            if (commit.bytes <= segment.loadedBytes) continue;
+
+            unique_ptr<MappedFile>& file = files[commit.month];
+            if (!file) file.reset(new MappedFile(segmentPath(commit.month)));
+            segment.loadedBytes = decodeSegment(*file, segment.loadedBytes, commit.bytes, columns, segment.cursor);
+        }
+    }
+
+    // Replaces the whole store with the given records, one segment per month
+    static bool writeSegments(const AttendanceColumns& all) {
+        int minDay = INT_MAX, maxDay = INT_MIN;
+        for (int day : all.days) {
+            minDay = min(minDay, day);
+            maxDay = max(maxDay, day);
+        }
+
+        map<string, vector<size_t>> byMonth;
+        vector<vector<size_t>*> bucketOfDay(all.size() > 0 ? static_cast<size_t>(static_cast<int64_t>(maxDay) - minDay) + 1 : 0, nullptr);
+        for (size_t i = 0; i < all.size(); i++) {
+            vector<size_t>*& bucket = bucketOfDay[all.days[i] - minDay];
+            if (!bucket) bucket = &byMonth[daysToDate(all.days[i]).substr(0, 7)];
+            bucket->push_back(i);
+        }
+
+        error_code ec;
+        filesystem::remove_all(ATTENDANCE_SEGMENT_DIR, ec);
+        filesystem::create_directories(ATTENDANCE_SEGMENT_DIR, ec);
+        if (ec) return false;
+
+        string manifest;
+        for (const auto& month : byMonth) {
+            string data(FILE_MAGIC, 8);
+            encodeRows(all, month.second, data);
+            if (!writeFileAtomically(segmentPath(month.first), data)) return false;
+
+            SegmentInfo info;
+            for (size_t i : month.second) {
+                info.firstDay = min(info.firstDay, all.days[i]);
+                info.lastDay = max(info.lastDay, all.days[i]);
+            }
+            info.records = month.second.size();
+            info.bytes = static_cast<streamoff>(data.size());
+            manifest += (manifest.empty() ? "" : ";") + manifestEntry(month.first, info);
+        }
+        if (!manifest.empty()) manifest += "\n";
+        if (!writeFileAtomically(ATTENDANCE_MANIFEST_FILE, manifest)) return false;
+
+        instance().loaded = false;
+        return true;
+    }
+
+    // Converts data kept by older versions: the single-file attendance.dat or, failing
+    // that, attendance.txt. Both are left in place.
+    static void migrate() {
+        if (getFileSize(LEGACY_ATTENDANCE_STORE_FILE) >= 0) {
+            MappedFile in(LEGACY_ATTENDANCE_STORE_FILE);
+            if (in.size() < 8 || memcmp(in.begin(), FILE_MAGIC, 8) != 0) return;
+            AttendanceColumns all;
+            SegmentCursor cursor;
+            decodeBlocks(in.begin() + 8, in.size() - 8, all, cursor);
+            writeSegments(all);
+        } else if (getFileSize(ATTENDANCE_FILE) >= 0) {
+            convertFromText(ATTENDANCE_FILE);
+        }
+    }
+
+public:
+    // Every record, including anything committed since the last call
+    static const AttendanceColumns& getColumns() {
+        AttendanceStore& store = instance();
+        store.updateColumns();
+        return store.columns;
+    }
+
+    // Bumped whenever the columns are reloaded from scratch
+    static unsigned long getGeneration() {
+        return instance().generation;
+    }
+
+    // Whether any segment's dates overlap firstDay..lastDay, answered from the manifest
+    // alone. Segments span whole months, so a day without classes can still say yes.
+    static bool hasRecordsIn(int firstDay, int lastDay) {
+        AttendanceStore& store = instance();
+        store.refresh();
+
+        for (const auto& entry : store.segments) {
+            const SegmentInfo& info = entry.second.info;
+            if (info.records > 0 && info.lastDay >= firstDay && info.firstDay <= lastDay) return true;
+        }
+        return false;
+    }
+
+    // Reads the records of every segment whose dates overlap firstDay..lastDay into
+    // 'target'. Whole segments are read, so callers still filter by day.
+    static bool readRange(int firstDay, int lastDay, AttendanceColumns& target) {
+        AttendanceStore& store = instance();
+        store.refresh();
+
+        target.clear();
+        bool ok = true;
+        for (const auto& entry : store.segments) {
+            const SegmentInfo& info = entry.second.info;
+            if (info.lastDay < firstDay || info.firstDay > lastDay) continue;
+
+            MappedFile file(segmentPath(entry.first));
+            SegmentCursor cursor;
+            if (decodeSegment(file, 0, info.bytes, target, cursor) != info.bytes) ok = false;
+        }
+        return ok;
+    }
+
+    // Appends the records to their months' segments, one checksummed block each written
+    // and synced, then commits them all with one manifest line. After a crash the commit
+    // is either complete or its blocks are ignored as an unfinished tail.
+    static bool append(const vector<Attendance>& records) {
+        if (records.empty()) return true;
+
+        AttendanceStore& store = instance();
+        store.refresh();
+
+        map<string, vector<Attendance>> byMonth;
+        for (const auto& record : records) {
+            if (dateToDays(record.getDate()) == INVALID_DAY) return false;
+            byMonth[record.getDate().substr(0, 7)].push_back(record);
+        }
+
+        error_code ec;
+        filesystem::create_directories(ATTENDANCE_SEGMENT_DIR, ec);
+        if (ec) return false;
+
+        string line;
+        for (const auto& month : byMonth) {
+            auto existing = store.segments.find(month.first);
+            SegmentInfo info = existing != store.segments.end() ? existing->second.info : SegmentInfo();
+            string path = segmentPath(month.first);
+
+            // The segment's own dictionaries, which the new block extends. They come from the
+            // columns when those hold the whole segment, else from decoding it.
+            AttendanceColumns known;
+            string block;
+            if (info.bytes == 0) {
+                block.append(FILE_MAGIC, 8);
+            } else if (existing->second.loadedBytes == info.bytes) {
+                store.segmentDictionaries(existing->second.cursor, known);
+            } else {
+                MappedFile file(path);
+                SegmentCursor cursor;
+                if (decodeSegment(file, 0, info.bytes, known, cursor) != info.bytes) return false;
+            }
+            if (!encodeBlock(month.second, known, block)) return false;
+
+            // Anything past the committed size is an unfinished commit; cut it off before appending
+            if (getFileSize(path) > info.bytes) {
+                filesystem::resize_file(path, static_cast<uintmax_t>(info.bytes), ec);
+                if (ec) return false;
+            }
+            if (!appendDurably(path, block)) return false;
+
+            for (const auto& record : month.second) {
+                int day = dateToDays(record.getDate());
+                info.firstDay = min(info.firstDay, day);
+                info.lastDay = max(info.lastDay, day);
+            }
+            info.records += month.second.size();
+            info.bytes += static_cast<streamoff>(block.size());
+            line += (line.empty() ? "" : ";") + manifestEntry(month.first, info);
+        }
+
+        if (getFileSize(ATTENDANCE_MANIFEST_FILE) > store.manifestBytes) {
+            filesystem::resize_file(ATTENDANCE_MANIFEST_FILE, static_cast<uintmax_t>(store.manifestBytes), ec);
+            if (ec) return false;
+        }
+        if (!appendDurably(ATTENDANCE_MANIFEST_FILE, line + "\n")) return false;
+
+        AttendanceCounterFile::advance(store.manifestBytes, store.manifestBytes + static_cast<streamoff>(line.size() + 1), records);
+        store.refresh();
+        return true;
+    }
+
+    // One-shot conversion of a pipe-delimited attendance file into segments, replacing
+    // the store; returns records converted or -1
+    static long convertFromText(const string& textFile) {
+        MappedFile in(textFile);
+        if (!in.isOpen()) return -1;
+
+        AttendanceColumns all;
+        RecordReader reader(in);
+        vector<string_view> fields;
+        while (reader.next(fields)) {
+            int day = dateToDays(string(fieldAt(fields, 1)));
+            if (day == INVALID_DAY) continue;
+            uint16_t subject = 0;
+            if (!all.internSubject(string(fieldAt(fields, 3)), subject)) return -1;
+            all.push(all.internRoll(string(fieldAt(fields, 0))), day, subject, fieldAt(fields, 2) == "P");
+        }
+
+        if (!writeSegments(all)) return -1;
+        return static_cast<long>(all.size());
+    }
+
+    // Writes the store back out in the original pipe-delimited text format
+    static bool exportText(const string& textFile) {
+        const AttendanceColumns& columns = getColumns();
+        ofstream out(textFile);
+        if (!out) return false;
+
+        for (size_t i = 0; i < columns.size(); i++) {
+            columns.record(i).saveToFile(out);
+        }
+        out.close();
+        return true;
+    }
+};
+
+// Row Set Class
+// A set of dense student rows, kept as a sorted array while sparse and as a bitset
+// once that is smaller (more than one row in 32 of the universe).
+class RowSet {
+private:
+    vector<uint32_t> rows;      // sorted, unless dense
+    vector<uint64_t> bits;      // dense form
+    bool dense;
+    size_t count;
+
+public:
+    RowSet() : dense(false), count(0) {}
+
+    // Takes sorted, distinct rows below universe and picks the smaller form
+    static RowSet fromSorted(vector<uint32_t> sorted, size_t universe) {
+        RowSet set;
+        set.count = sorted.size();
+        if (set.count * 32 > universe) {
+            set.dense = true;
+            set.bits.assign((universe + 63) / 64, 0);
+            for (uint32_t row : sorted) set.bits[row >> 6] |= uint64_t(1) << (row & 63);
+        } else {
+            set.rows.swap(sorted);
+        }
+        return set;
+    }
+
+    size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+
+    bool contains(uint32_t row) const {
+        if (dense) return (row >> 6) < bits.size() && ((bits[row >> 6] >> (row & 63)) & 1);
+        return binary_search(rows.begin(), rows.end(), row);
+    }
+
+    // Visits the rows in ascending order
+    template <typename Visitor>
+    void forEach(const Visitor& visit) const {
+        if (!dense) {
+            for (uint32_t row : rows) visit(row);
+            return;
+        }
+        for (size_t w = 0; w < bits.size(); w++) {
+            for (uint64_t word = bits[w]; word; word &= word - 1) {
+                visit(static_cast<uint32_t>(w * 64 + countTrailingZeros(word)));
+            }
+        }
+    }
+
+    static RowSet intersect(const RowSet& a, const RowSet& b, size_t universe) {
+        if (a.dense && b.dense) {
+            RowSet set;
+            set.dense = true;
+            set.bits.resize(min(a.bits.size(), b.bits.size()));
+            for (size_t w = 0; w < set.bits.size(); w++) set.bits[w] = a.bits[w] & b.bits[w];
+            set.count = static_cast<size_t>(BitCount::words(set.bits.data(), set.bits.size()));
+            if (set.count * 32 > universe) return set;
+            vector<uint32_t> sorted;
+            set.forEach([&](uint32_t row) { sorted.push_back(row); });
+            return fromSorted(sorted, universe);
+        }
+
+        // Walk the sparse side and probe the other
+        const RowSet& probe = a.dense ? a : b;
+        const RowSet& walk = a.dense ? b : a;
+        vector<uint32_t> sorted;
+        for (uint32_t row : walk.rows) {
+            if (probe.contains(row)) sorted.push_back(row);
+        }
+        return fromSorted(sorted, universe);
+    }
+};
+
+// Attendance Index Class
+// Per-student attendance bitmaps built from one pass over the attendance store. Each
+// student has a track per subject; a track is a pair of bitsets (held, present) over
+// the dense list of class days, so counts and percentages are population counts and a
+// whole-class figure is one sweep over the contiguous arenas. A second mark for the
+// same student, subject and day lands in a small per-track repeat counter.
+// Day rosters (who was present or absent on a day, per subject and for any subject)
+// are the same bitmaps read the other way: a day's column is gathered once into
+// RowSets on first use and kept until a record for that day arrives.
+// The index remembers how many records it has consumed, so later syncs only apply
+// the records appended since then; a reloaded store is re-indexed from scratch.
+// An index restored from the warm start file answers without loading the store at
+// all until the attendance manifest changes size.
+class AttendanceIndex {
+private:
+    static constexpr uint32_t NONE = UINT32_MAX;
+
+    vector<string> rolls;                       // dense student rows
+    unordered_map<string, uint32_t> rowOf;
+    vector<vector<uint32_t>> tracksOf;          // row -> tracks in first-seen subject order
+    vector<string> subjectNames;                // id 0 = no subject
+    unordered_map<string, uint32_t> subjectIds;
+
+    struct Roster {
+        RowSet present;
+        RowSet absent;
+    };
+
+    vector<uint32_t> trackRow;
+    vector<uint32_t> trackSubject;
+    vector<uint64_t> held;                      // tracks x stride words, bit i = classDays[i]
+    vector<uint64_t> present;
+    size_t stride;
+    unordered_map<uint32_t, AttendanceCounter> repeats;
+    unordered_map<int, map<uint32_t, Roster>> rosters;     // day -> subject (0 = any) -> roster
+
+    // Store dictionary id -> index id, filled in as records are applied
+    vector<uint32_t> rowOfColumn;
+    vector<uint32_t> subjectOfColumn;
+
+    vector<int> classDays;
+    size_t indexedRecords;
+    unsigned long storeGeneration;
+    bool loaded;
+    unsigned long generation;
+    streamoff restoredBytes;        // manifest size a warm-started index covers; -1 once caught up
+    function<void(const string&, const string&, const AttendanceCounter&, const AttendanceCounter&)> listener;
+
+    AttendanceIndex() : stride(0), indexedRecords(0), storeGeneration(0), loaded(false), generation(0), restoredBytes(-1) {
+        clear();
+    }
+
+    static AttendanceIndex& instance() {
+        static AttendanceIndex index;
+        return index;
+    }
+
+    void clear() {
+        rolls.clear();
+        rowOf.clear();
+        tracksOf.clear();
+        subjectNames.assign(1, "");
+        subjectIds.clear();
+        trackRow.clear();
+        trackSubject.clear();
+        held.clear();
+        present.clear();
+        stride = 0;
+        repeats.clear();
+        rosters.clear();
+        rowOfColumn.clear();
+        subjectOfColumn.clear();
+        classDays.clear();
+    }
+
+    static void setBit(vector<uint64_t>& arena, size_t word, size_t bit) {
+        arena[word + (bit >> 6)] |= uint64_t(1) << (bit & 63);
+    }
+
+    static bool testBit(const vector<uint64_t>& arena, size_t word, size_t bit) {
+        return (arena[word + (bit >> 6)] >> (bit & 63)) & 1;
+    }
+
+    AttendanceCounter countTrack(uint32_t track) const {
+        AttendanceCounter counter;
+        counter.total = static_cast<int>(BitCount::words(held.data() + track * stride, stride));
+        counter.present = static_cast<int>(BitCount::words(present.data() + track * stride, stride));
+        if (!repeats.empty()) {
+            auto it = repeats.find(track);
+            if (it != repeats.end()) {
+                counter.total += it->second.total;
+                counter.present += it->second.present;
+            }
+        }
+        return counter;
+    }
+
+    AttendanceCounter countRow(uint32_t row) const {
+        AttendanceCounter counter;
+        for (uint32_t track : tracksOf[row]) {
+            AttendanceCounter part = countTrack(track);
+            counter.total += part.total;
+            counter.present += part.present;
+        }
+        return counter;
+    }
+
+    uint32_t rowFor(const AttendanceColumns& columns, uint32_t rollId) {
+        if (rollId >= rowOfColumn.size()) rowOfColumn.resize(columns.rollDict.size(), NONE);
+        uint32_t& row = rowOfColumn[rollId];
+        if (row == NONE) {
+            const string& roll = columns.rollDict[rollId];
+            auto it = rowOf.emplace(roll, static_cast<uint32_t>(rolls.size()));
+            if (it.second) {
+                rolls.push_back(roll);
+                tracksOf.emplace_back();
+            }
+            row = it.first->second;
+        }
+        return row;
+    }
+
+    uint32_t subjectFor(const AttendanceColumns& columns, uint16_t subjectId) {
+        if (subjectId >= subjectOfColumn.size()) subjectOfColumn.resize(columns.subjectDict.size(), NONE);
+        uint32_t& id = subjectOfColumn[subjectId];
+        if (id == NONE) {
+            const string& subject = columns.subjectDict[subjectId];
+            if (subject.empty()) {
+                id = 0;
+            } else {
+                auto it = subjectIds.emplace(subject, static_cast<uint32_t>(subjectNames.size()));
+                if (it.second) subjectNames.push_back(subject);
+                id = it.first->second;
+            }
+        }
+        return id;
+    }
+
+    uint32_t trackFor(uint32_t row, uint32_t subject) {
+        for (uint32_t track : tracksOf[row]) {
+            if (trackSubject[track] == subject) return track;
+        }
+        uint32_t track = static_cast<uint32_t>(trackSubject.size());
+        trackRow.push_back(row);
+        trackSubject.push_back(subject);
+        tracksOf[row].push_back(track);
+        held.resize(held.size() + stride, 0);
+        present.resize(present.size() + stride, 0);
+        return track;
+    }
+
+    // Moves every track onto a new day list (a superset of the current one) and row width
+    void relayout(const vector<int>& days, size_t newStride) {
+        size_t tracks = trackSubject.size();
+        bool appendOnly = classDays.empty() || days[classDays.size() - 1] == classDays.back();
+        vector<uint64_t> newHeld(tracks * newStride, 0), newPresent(tracks * newStride, 0);
+
+        if (appendOnly) {
+            // Words past the last class day are zero, so a narrower row loses nothing
+            size_t words = min(stride, newStride);
+            for (size_t t = 0; t < tracks; t++) {
+                copy_n(held.begin() + t * stride, words, newHeld.begin() + t * newStride);
+                copy_n(present.begin() + t * stride, words, newPresent.begin() + t * newStride);
+            }
+        } else {
+            vector<uint32_t> position(classDays.size());
+            for (size_t i = 0, j = 0; i < classDays.size(); i++) {
+                while (days[j] != classDays[i]) j++;
+                position[i] = static_cast<uint32_t>(j);
+            }
+            for (size_t t = 0; t < tracks; t++) {
+                for (size_t w = 0; w < stride; w++) {
+                    for (uint64_t bits = held[t * stride + w]; bits; bits &= bits - 1) {
+                        size_t bit = w * 64 + static_cast<size_t>(countTrailingZeros(bits));
+                        setBit(newHeld, t * newStride, position[bit]);
+                        if (testBit(present, t * stride, bit)) setBit(newPresent, t * newStride, position[bit]);
+                    }
+                }
+            }
+        }
+
+        held.swap(newHeld);
+        present.swap(newPresent);
+        stride = newStride;
+        classDays = days;
+    }
+
+    // Adds the class days of records [from, to) in one step, so that a backdated import
+    // moves the existing bits once rather than once per new day
+    void addDays(const AttendanceColumns& columns, size_t from, size_t to) {
+        vector<int> added;
+        int last = INVALID_DAY;
+        for (size_t i = from; i < to; i++) {
+            int day = columns.days[i];
+            if (day == last) continue;
+            last = day;
+            if (!binary_search(classDays.begin(), classDays.end(), day)) added.push_back(day);
+        }
+        if (added.empty()) return;
+        sort(added.begin(), added.end());
+        added.erase(unique(added.begin(), added.end()), added.end());
+
+        vector<int> days;
+        days.reserve(classDays.size() + added.size());
+        merge(classDays.begin(), classDays.end(), added.begin(), added.end(), back_inserter(days));
+
+        size_t needed = (days.size() + 63) / 64;
+        bool appendOnly = classDays.empty() || added.front() > classDays.back();
+        if (appendOnly && needed <= stride) {
+            classDays.swap(days);
+        } else {
+            relayout(days, needed <= stride ? stride : needed + needed / 4);
+        }
+    }
+
+    void apply(const AttendanceColumns& columns, size_t i, bool notify) {
+        uint32_t row = rowFor(columns, columns.rolls[i]);
+        uint32_t subject = subjectFor(columns, columns.subjects[i]);
+        uint32_t track = trackFor(row, subject);
+        bool isPresent = columns.isPresent(i);
+
+        int day = columns.days[i];
+        if (!rosters.empty()) rosters.erase(day);
+        size_t bit = day == classDays.back() ? classDays.size() - 1
+                   : static_cast<size_t>(lower_bound(classDays.begin(), classDays.end(), day) - classDays.begin());
+
+        AttendanceCounter overallBefore, subjectBefore;
+        if (notify) {
+            overallBefore = countRow(row);
+            subjectBefore = countTrack(track);
+        }
+
+        size_t word = track * stride;
+        if (!testBit(held, word, bit)) {
+            setBit(held, word, bit);
+            if (isPresent) setBit(present, word, bit);
+        } else {
+            AttendanceCounter& repeat = repeats[track];
+            repeat.total++;
+            if (isPresent) repeat.present++;
+        }
+
+        if (notify) {
+            AttendanceCounter overallAfter = overallBefore, subjectAfter = subjectBefore;
+            overallAfter.total++;
+            subjectAfter.total++;
+            if (isPresent) {
+                overallAfter.present++;
+                subjectAfter.present++;
+            }
+            listener(rolls[row], "", overallBefore, overallAfter);
+            if (subject != 0) listener(rolls[row], subjectNames[subject], subjectBefore, subjectAfter);
+        }
+    }
+
+    // Rosters of one class day, gathered from that day's bit in every track
+    const map<uint32_t, Roster>& rostersOf(int day) {
+        auto cached = rosters.find(day);
+        if (cached != rosters.end()) return cached->second;
+
+        map<uint32_t, Roster>& dayRosters = rosters[day];
+        auto position = lower_bound(classDays.begin(), classDays.end(), day);
+        if (position == classDays.end() || *position != day) return dayRosters;
+
+        size_t bit = static_cast<size_t>(position - classDays.begin());
+        size_t word = bit >> 6;
+        uint64_t mask = uint64_t(1) << (bit & 63);
+        map<uint32_t, pair<vector<uint32_t>, vector<uint32_t>>> marked;     // subject -> (present, absent)
+        for (size_t t = 0; t < trackSubject.size(); t++) {
+            if (!(held[t * stride + word] & mask)) continue;
+            auto& lists = marked[trackSubject[t]];
+            bool wasPresent = (present[t * stride + word] & mask) != 0;
+            (wasPresent ? lists.first : lists.second).push_back(trackRow[t]);
+        }
+
+        // "Any subject" is the union over subjects: present in some class, absent from some class
+        vector<uint32_t> anyPresent, anyAbsent;
+        for (auto& lists : marked) {
+            sort(lists.second.first.begin(), lists.second.first.end());
+            sort(lists.second.second.begin(), lists.second.second.end());
+            anyPresent.insert(anyPresent.end(), lists.second.first.begin(), lists.second.first.end());
+            anyAbsent.insert(anyAbsent.end(), lists.second.second.begin(), lists.second.second.end());
+            if (lists.first == 0) continue;
+            dayRosters[lists.first] = {RowSet::fromSorted(move(lists.second.first), rolls.size()),
+                                       RowSet::fromSorted(move(lists.second.second), rolls.size())};
+        }
+        for (vector<uint32_t>* rowList : {&anyPresent, &anyAbsent}) {
+            sort(rowList->begin(), rowList->end());
+            rowList->erase(unique(rowList->begin(), rowList->end()), rowList->end());
+        }
+        dayRosters[0] = {RowSet::fromSorted(move(anyPresent), rolls.size()), RowSet::fromSorted(move(anyAbsent), rolls.size())};
+        return dayRosters;
+    }
+
+    // Roster of one day and subject; an empty one if nobody was marked
+    const Roster& rosterOf(int day, const string& subject) {
+        static const Roster none;
+        uint32_t id = 0;
+        if (!subject.empty()) {
+            auto it = subjectIds.find(subject);
+            if (it == subjectIds.end()) return none;
+            id = it->second;
+        }
+        const map<uint32_t, Roster>& dayRosters = rostersOf(day);
+        auto it = dayRosters.find(id);
+        return it != dayRosters.end() ? it->second : none;
+    }
+
+    void update() {
+        if (restoredBytes >= 0) {
+            if (getFileSize(ATTENDANCE_MANIFEST_FILE) == restoredBytes) return;
+            // The store grew past the warm start; load it and carry on from the restored count
+            restoredBytes = -1;
+            AttendanceStore::getColumns();
+            storeGeneration = AttendanceStore::getGeneration();
+        }
+
+        const AttendanceColumns& columns = AttendanceStore::getColumns();
+        bool rebuilt = false;
+        if (!loaded || storeGeneration != AttendanceStore::getGeneration() || columns.size() < indexedRecords) {
+            clear();
+            indexedRecords = 0;
+            storeGeneration = AttendanceStore::getGeneration();
+            loaded = true;
+            generation++;
+            rebuilt = true;
+        }
+        if (indexedRecords == columns.size()) return;
+
+        // A rebuilt index announces itself through the generation instead of per record
+        addDays(columns, indexedRecords, columns.size());
+        bool notify = listener && !rebuilt;
+        for (; indexedRecords < columns.size(); indexedRecords++) {
+            apply(columns, indexedRecords, notify);
+        }
+    }
+
+    uint32_t findRow(const string& rollNo) const {
+        auto it = rowOf.find(rollNo);
+        return it != rowOf.end() ? it->second : NONE;
+    }
+
+public:
+    // Picks up records appended to the attendance store since the last sync
+    static void sync() {
+        instance().update();
+    }
+
+    // Bumped whenever the index is rebuilt from scratch
+    static unsigned long getGeneration() {
+        return instance().generation;
+    }
+
+    // Called with (rollNo, subject, before, after) for every counter an applied record changes;
+    // subject is empty for the overall counter
+    static void setListener(function<void(const string&, const string&, const AttendanceCounter&, const AttendanceCounter&)> callback) {
+        instance().listener = callback;
+    }
+
+    static AttendanceCounter lookup(const string& rollNo, const string& subject = "") {
+        AttendanceIndex& index = instance();
+        index.update();
+
+        uint32_t row = index.findRow(rollNo);
+        if (row == NONE) return AttendanceCounter();
+        PerfCounters::add(PerfCounters::RECORDS_MATCHED);
+        if (subject.empty()) return index.countRow(row);
+
+        auto id = index.subjectIds.find(subject);
+        if (id == index.subjectIds.end()) return AttendanceCounter();
+        for (uint32_t track : index.tracksOf[row]) {
+            if (index.trackSubject[track] == id->second) return index.countTrack(track);
+        }
+        return AttendanceCounter();
+    }
+
+    // Overall counters for each of the given students, in the same order
+    static vector<AttendanceCounter> totalsFor(const vector<Student>& students) {
+        AttendanceIndex& index = instance();
+        index.update();
+
+        vector<AttendanceCounter> totals(students.size());
+        size_t matched = 0;
+        for (size_t k = 0; k < students.size(); k++) {
+            uint32_t row = index.findRow(students[k].getRollNo());
+            if (row == NONE) continue;
+            totals[k] = index.countRow(row);
+            matched++;
+        }
+        PerfCounters::add(PerfCounters::RECORDS_MATCHED, matched);
+        return totals;
+    }
+
+    // Calls visit(k, subject, counter) for each of the given students: once with subject ""
+    // for the overall counter, then once per subject the student has records for
+    template <typename Visitor>
+    static void sweep(const vector<Student>& students, const Visitor& visit) {
+        AttendanceIndex& index = instance();
+        index.update();
+
+        size_t matched = 0;
+        for (size_t k = 0; k < students.size(); k++) {
+            uint32_t row = index.findRow(students[k].getRollNo());
+            if (row == NONE) {
+                visit(k, string(), AttendanceCounter());
+                continue;
+            }
+            matched++;
+            visit(k, string(), index.countRow(row));
+            for (uint32_t track : index.tracksOf[row]) {
+                uint32_t subject = index.trackSubject[track];
+                if (subject != 0) visit(k, index.subjectNames[subject], index.countTrack(track));
+            }
+        }
+        PerfCounters::add(PerfCounters::RECORDS_MATCHED, matched);
+    }
+
+    // Calls visit(rollNo, subject, counter) for every student in the store, in the order
+    // they were first recorded: once with subject "" for the overall counter, then once
+    // per subject
+    template <typename Visitor>
+    static void sweepAll(const Visitor& visit) {
+        AttendanceIndex& index = instance();
+        index.update();
+
+        for (uint32_t row = 0; row < index.rolls.size(); row++) {
+            visit(index.rolls[row], string(), index.countRow(row));
+            for (uint32_t track : index.tracksOf[row]) {
+                uint32_t subject = index.trackSubject[track];
+                if (subject != 0) visit(index.rolls[row], index.subjectNames[subject], index.countTrack(track));
+            }
+        }
+    }
+
+    // Counters over every record in the store, from one sweep over the bitmaps
+    static AttendanceCounter classTotals() {
+        AttendanceIndex& index = instance();
+        index.update();
+
+        AttendanceCounter counter;
+        counter.total = static_cast<int>(BitCount::words(index.held.data(), index.held.size()));
+        counter.present = static_cast<int>(BitCount::words(index.present.data(), index.present.size()));
+        for (const auto& repeat : index.repeats) {
+            counter.total += repeat.second.total;
+            counter.present += repeat.second.present;
+        }
+        return counter;
+    }
+
+    // Sorted day numbers that have at least one attendance record
+    static vector<int> getClassDays() {
+        AttendanceIndex& index = instance();
+        index.update();
+        return index.classDays;
+    }
+
+    static vector<string> subjectsFor(const string& rollNo) {
+        AttendanceIndex& index = instance();
+        index.update();
+
+        vector<string> subjects;
+        uint32_t row = index.findRow(rollNo);
+        if (row == NONE) return subjects;
+        for (uint32_t track : index.tracksOf[row]) {
+            uint32_t subject = index.trackSubject[track];
+            if (subject != 0) subjects.push_back(index.subjectNames[subject]);
+        }
+        return subjects;
+    }
+
+    // Students marked on a day (optionally in one subject; "" = any subject): total
+    // is how many were marked, present how many attended at least one such class
+    static AttendanceCounter dayCounts(int day, const string& subject = "") {
+        AttendanceIndex& index = instance();
+        index.update();
+
+        const Roster& roster = index.rosterOf(day, subject);
+        size_t both = RowSet::intersect(roster.present, roster.absent, index.rolls.size()).size();
+        AttendanceCounter counter;
+        counter.present = static_cast<int>(roster.present.size());
+        counter.total = static_cast<int>(roster.present.size() + roster.absent.size() - both);
+        return counter;
+    }
+
+    // Roll numbers absent on every one of the given days (optionally in one subject;
+    // "" = absent from any class that day), in the order students were first recorded
+    static vector<string> absentOnAll(const vector<int>& days, const string& subject = "") {
+        AttendanceIndex& index = instance();
+        index.update();
+
+        vector<string> absent;
+        if (days.empty()) return absent;
+        RowSet common = index.rosterOf(days[0], subject).absent;
+        for (size_t i = 1; i < days.size() && !common.empty(); i++) {
+            common = RowSet::intersect(common, index.rosterOf(days[i], subject).absent, index.rolls.size());
+        }
+        absent.reserve(common.size());
+        common.forEach([&](uint32_t row) { absent.push_back(index.rolls[row]); });
+        return absent;
+    }
+
+    // Warm start image: the bitmaps at their tightest width, the class days and how many
+    // records they cover. Tracks are written in creation order, which per student is
+    // first-seen subject order.
+    static void saveWarmStart(BinaryWriter& writer) {
+        AttendanceIndex& index = instance();
+        index.update();
+
+        size_t width = (index.classDays.size() + 63) / 64;
+        if (width != index.stride) index.relayout(index.classDays, width);
+
+        writer.write<uint64_t>(index.indexedRecords);
+        writer.write<uint32_t>(static_cast<uint32_t>(index.classDays.size()));
+        writer.writeArray(index.classDays);
+        writer.write<uint32_t>(static_cast<uint32_t>(index.rolls.size()));
+        for (const auto& roll : index.rolls) writer.writeString(roll);
+        writer.write<uint32_t>(static_cast<uint32_t>(index.subjectNames.size()));
+        for (size_t i = 1; i < index.subjectNames.size(); i++) writer.writeString(index.subjectNames[i]);
+        writer.write<uint32_t>(static_cast<uint32_t>(index.trackRow.size()));
+        writer.writeArray(index.trackRow);
+        writer.writeArray(index.trackSubject);
+        writer.writeArray(index.held);
+        writer.writeArray(index.present);
+        writer.write<uint32_t>(static_cast<uint32_t>(index.repeats.size()));
+        for (const auto& repeat : index.repeats) {
+            writer.write<uint32_t>(repeat.first);
+            writer.write<int32_t>(repeat.second.total);
+            writer.write<int32_t>(repeat.second.present);
+        }
+    }
+
+    static bool loadWarmStart(BinaryReader& reader) {
+        // A missing store may still have to be converted from attendance.txt
+        streamoff size = getFileSize(ATTENDANCE_MANIFEST_FILE);
+        if (size < 0) return false;
+
+        AttendanceIndex loaded;
+        uint64_t records = reader.read<uint64_t>();
+        reader.readArray(loaded.classDays, reader.read<uint32_t>());
+        loaded.stride = (loaded.classDays.size() + 63) / 64;
+
+        uint32_t rollCount = reader.read<uint32_t>();
+        for (uint32_t i = 0; i < rollCount && reader.ok(); i++) {
+            loaded.rowOf.emplace(reader.readString(), i);
+        }
+        loaded.rolls.resize(loaded.rowOf.size());
+        for (const auto& roll : loaded.rowOf) loaded.rolls[roll.second] = roll.first;
+        loaded.tracksOf.resize(loaded.rolls.size());
+
+        uint32_t subjectCount = reader.read<uint32_t>();
+        for (uint32_t i = 1; i < subjectCount && reader.ok(); i++) {
+            loaded.subjectNames.push_back(reader.readString());
+            loaded.subjectIds.emplace(loaded.subjectNames.back(), i);
+        }
+
+        uint32_t tracks = reader.read<uint32_t>();
+        reader.readArray(loaded.trackRow, tracks);
+        reader.readArray(loaded.trackSubject, tracks);
+        reader.readArray(loaded.held, static_cast<size_t>(tracks) * loaded.stride);
+        reader.readArray(loaded.present, static_cast<size_t>(tracks) * loaded.stride);
+        uint32_t repeatCount = reader.read<uint32_t>();
+        for (uint32_t i = 0; i < repeatCount && reader.ok(); i++) {
+            AttendanceCounter& repeat = loaded.repeats[reader.read<uint32_t>()];
+            repeat.total = reader.read<int32_t>();
+            repeat.present = reader.read<int32_t>();
+        }
+        if (!reader.ok() || loaded.rolls.size() != rollCount || loaded.subjectNames.size() != subjectCount) return false;
+
+        for (uint32_t track = 0; track < tracks; track++) {
+            if (loaded.trackRow[track] >= rollCount || loaded.trackSubject[track] >= subjectCount) return false;
+            loaded.tracksOf[loaded.trackRow[track]].push_back(track);
+        }
+
+        AttendanceIndex& index = instance();
+        index.rolls.swap(loaded.rolls);
+        index.rowOf.swap(loaded.rowOf);
+        index.tracksOf.swap(loaded.tracksOf);
+        index.subjectNames.swap(loaded.subjectNames);
+        index.subjectIds.swap(loaded.subjectIds);
+        index.trackRow.swap(loaded.trackRow);
+        index.trackSubject.swap(loaded.trackSubject);
+        index.held.swap(loaded.held);
+        index.present.swap(loaded.present);
+        index.stride = loaded.stride;
+        index.repeats.swap(loaded.repeats);
+        index.rosters.clear();
+        index.rowOfColumn.clear();
+        index.subjectOfColumn.clear();
+        index.classDays.swap(loaded.classDays);
+        index.indexedRecords = static_cast<size_t>(records);
+        index.loaded = true;
+        index.generation++;
+        index.restoredBytes = size;
+        return true;
+    }
+};
+
+double Attendance::calculateAttendancePercentage(const string& rollNo, const string& subject) {
+    PerfScope scope("attendance.percentage");
+    AttendanceCounter counter = AttendanceIndex::lookup(rollNo, subject);
+    return counter.total > 0 ? (static_cast<double>(counter.present) / counter.total) * 100 : 0.0;
+}
+
+vector<string> Attendance::getAvailableDates() {
+    PerfScope scope("attendance.dates");
+    vector<string> dates;
+    for (int day : AttendanceIndex::getClassDays()) {
+        dates.push_back(daysToDate(day));
+    }
+    return dates;
+}
+
+vector<string> Attendance::getSubjectsForStudent(const string& rollNo) {
+    PerfScope scope("attendance.subjects");
+    return AttendanceIndex::subjectsFor(rollNo);
+}
+
+bool AttendanceCounterFile::rebuild() {
+    PerfScope scope("attendance.counters-rebuild");
+    if (fold()) return true;
+
+    AttendanceIndex::sync();
+    Contents contents;
+    if (!currentStamp(contents.stamp)) return false;
+
+    // The index has to cover exactly the stamped manifest
+    AttendanceIndex::sync();
+    Stamp after;
+    if (!currentStamp(after) || !(after == contents.stamp)) return false;
+
+    unordered_map<string, uint16_t> subjectIds;
+    contents.subjects.assign(1, "");
+    bool ok = true;
+    AttendanceIndex::sweepAll([&](const string& rollNo, const string& subject, const AttendanceCounter& counter) {
+        if (subject.empty()) {
+            contents.entries.push_back({rollNo, {{0, counter}}});
+            return;
+        }
+        auto id = subjectIds.find(subject);
+        if (id == subjectIds.end()) {
+            if (contents.subjects.size() > UINT16_MAX) {
+                ok = false;
+                return;
+            }
+            id = subjectIds.emplace(subject, static_cast<uint16_t>(contents.subjects.size())).first;
+            contents.subjects.push_back(subject);
+        }
+        contents.entries.back().counters.push_back({id->second, counter});
+    });
+    if (!ok) return false;
+
+    sort(contents.entries.begin(), contents.entries.end(),
+         [](const Entry& a, const Entry& b) { return a.rollNo < b.rollNo; });
+    if (!writeFileAtomically(ATTENDANCE_COUNTERS_FILE, encode(contents))) return false;
+
+    error_code ec;
+    filesystem::remove(ATTENDANCE_COUNTER_DELTAS_FILE, ec);
+    return true;
+}
+
+AttendanceCounterFile::Summary AttendanceCounterFile::forStudent(const string& rollNo) {
+    PerfScope scope("attendance.counters");
+    Summary summary;
+    if (lookup(rollNo, summary)) {
+        // Each lookup reads the deltas, so they are folded in once they outgrow a quarter
+        // of the file; the fold then costs about as much as the deltas it absorbs
+        if (getFileSize(ATTENDANCE_COUNTER_DELTAS_FILE) > getFileSize(ATTENDANCE_COUNTERS_FILE) / 4) rebuild();
+        return summary;
+    }
+    if (rebuild() && lookup(rollNo, summary)) return summary;
+
+    // The file could not be written; answer from the index directly
+    summary = Summary();
+    summary.overall = AttendanceIndex::lookup(rollNo);
+    for (const auto& subject : AttendanceIndex::subjectsFor(rollNo)) {
+        summary.subjects.push_back({subject, AttendanceIndex::lookup(rollNo, subject)});
+    }
+    return summary;
+}
+
+// Attendance Batch Class
+// Gathers a whole roll call in memory and commits it as one block of the attendance
+// store, so a marking session is saved completely or not at all.
+class AttendanceBatch {
+private:
+    vector<Attendance> records;
+
+public:
+    void add(const string& rollNo, const string& date, const string& status, const string& subject = "") {
+        records.push_back(Attendance(rollNo, date, status, subject));
+    }
+
+    size_t size() const { return records.size(); }
+
+    bool commit() {
+        // The index catches up on its next read; building it here would make every
+        // command-line write load the whole store
+        if (!AttendanceStore::append(records)) return false;
+        records.clear();
+        return true;
+    }
+};
+
+// Rollup Cell - aggregates for one department x semester x subject group
+struct RollupCell {
+    int headcount;
+    int present;
+    int total;
+    int good;
+    int average;
+    int poor;
+    double percentageSum;
+
+    RollupCell() : headcount(0), present(0), total(0), good(0), average(0), poor(0), percentageSum(0.0) {}
+};
+
+// Department Rollup Class
+// Materialized department x semester x subject cube (subject "" = all subjects).
+// Student membership is maintained by Admin; attendance changes arrive through the
+// AttendanceIndex listener, so readers never touch the data files.
+class DepartmentRollup {
+private:
+    struct Member {
+        string department;
+        int semester;
+    };
+
+    map<string, map<int, map<string, RollupCell>>> cube;
+    unordered_map<string, Member> members;
+    bool built;
+    unsigned long indexGeneration;
+    unsigned long studentGeneration;
+
+    DepartmentRollup() : built(false), indexGeneration(0), studentGeneration(0) {}
+
+    static DepartmentRollup& instance() {
+        static DepartmentRollup rollup;
+        return rollup;
+    }
+
+    static double percentageOf(const AttendanceCounter& counter) {
+        return counter.total > 0 ? (static_cast<double>(counter.present) / counter.total) * 100 : 0.0;
+    }
+
+    // Adds (sign = 1) or withdraws (sign = -1) one student's counters from a cell
+    void contribute(const Member& member, const string& subject, const AttendanceCounter& counter, int sign) {
+        // Subject cells only count students that have records for the subject
+        if (!subject.empty() && counter.total == 0) return;
+
+        RollupCell& cell = cube[member.department][member.semester][subject];
+        double percentage = percentageOf(counter);
+
+        cell.headcount += sign;
+        cell.present += sign * counter.present;
+        cell.total += sign * counter.total;
+        cell.percentageSum += sign * percentage;
+        if (percentage >= 75) cell.good += sign;
+        else if (percentage >= 50) cell.average += sign;
+        else cell.poor += sign;
+    }
+
+    void addMember(const Student& student, int sign) {
+        Member member = {student.getDepartment(), student.getSemester()};
+        contribute(member, "", AttendanceIndex::lookup(student.getRollNo()), sign);
+        for (const auto& subject : AttendanceIndex::subjectsFor(student.getRollNo())) {
+            contribute(member, subject, AttendanceIndex::lookup(student.getRollNo(), subject), sign);
+        }
+    }
+
+    void catchUp() {
+        if (studentGeneration + 1 == StudentRepository::getGeneration()) studentGeneration++;
+    }
+
+    void onAttendance(const string& rollNo, const string& subject,
+                      const AttendanceCounter& before, const AttendanceCounter& after) {
+        if (!built) return;
+        auto it = members.find(rollNo);
+        if (it == members.end()) return;
+
+        contribute(it->second, subject, before, -1);
+        contribute(it->second, subject, after, 1);
+    }
+
+    void build() {
+        // Catch the index up first so that no listener call lands mid-build. The student
+        // generation is read before the rows, so a reload in between only means another build.
+        built = false;
+        AttendanceIndex::sync();
+        studentGeneration = StudentRepository::getGeneration();
+        vector<Student> students = StudentRepository::all();
+
+        cube.clear();
+        members.clear();
+        vector<const Member*> rows(students.size());
+        for (size_t k = 0; k < students.size(); k++) {
+            const Student& student = students[k];
+            rows[k] = &(members[student.getRollNo()] = {student.getDepartment(), student.getSemester()});
+        }
+        AttendanceIndex::sweep(students, [&](size_t k, const string& subject, const AttendanceCounter& counter) {
+            contribute(*rows[k], subject, counter, 1);
+        });
+
+        indexGeneration = AttendanceIndex::getGeneration();
+        built = true;
+        AttendanceIndex::setListener([this](const string& rollNo, const string& subject,
+                                            const AttendanceCounter& before, const AttendanceCounter& after) {
+            onAttendance(rollNo, subject, before, after);
+        });
+    }
+
+public:
+    // Makes sure the cube covers the current student table and the latest attendance
+    static void ensure() {
+        DepartmentRollup& rollup = instance();
+        if (rollup.built) AttendanceIndex::sync();
+
+        if (!rollup.built || rollup.indexGeneration != AttendanceIndex::getGeneration() ||
+            rollup.studentGeneration != StudentRepository::getGeneration()) {
+            rollup.build();
+        }
+    }
+
+    // addStudent and removeStudent mirror a StudentRepository write just made. That write
+    // bumped the generation once; any other bump means the table changed in ways the cube
+    // has not seen, and it is left to be rebuilt.
+    static void addStudent(const Student& student) {
+        DepartmentRollup& rollup = instance();
+        if (!rollup.built || rollup.members.count(student.getRollNo())) return;
+
+        rollup.members[student.getRollNo()] = {student.getDepartment(), student.getSemester()};
+        rollup.addMember(student, 1);
+        rollup.catchUp();
+    }
+
+    static void removeStudent(const Student& student) {
+        DepartmentRollup& rollup = instance();
+        auto it = rollup.members.find(student.getRollNo());
+        if (!rollup.built || it == rollup.members.end()) return;
+
+        Student stored(student.getRollNo(), "", it->second.department, it->second.semester);
+        rollup.addMember(stored, -1);
+        rollup.members.erase(it);
+        rollup.catchUp();
+    }
+
+    // Department -> cell summed over semesters (all subjects)
+    static map<string, RollupCell> byDepartment() {
+        map<string, RollupCell> result;
+        for (const auto& dept : instance().cube) {
+            RollupCell& sum = result[dept.first];
+            for (const auto& sem : dept.second) {
+                auto cell = sem.second.find("");
+                if (cell == sem.second.end()) continue;
+                sum.headcount += cell->second.headcount;
+                sum.present += cell->second.present;
+                sum.total += cell->second.total;
+                sum.good += cell->second.good;
+                sum.average += cell->second.average;
+                sum.poor += cell->second.poor;
+                sum.percentageSum += cell->second.percentageSum;
+            }
+        }
+        return result;
+    }
+
+    static map<int, int> headcountBySemester() {
+        map<int, int> result;
+        for (const auto& dept : instance().cube) {
+            for (const auto& sem : dept.second) {
+                auto cell = sem.second.find("");
+                if (cell != sem.second.end() && cell->second.headcount > 0) result[sem.first] += cell->second.headcount;
+            }
+        }
+        return result;
+    }
+
+    // Single cell lookup; subject "" gives the all-subjects cell
+    static RollupCell cell(const string& department, int semester, const string& subject = "") {
+        const auto& cube = instance().cube;
+        auto dept = cube.find(department);
+        if (dept == cube.end()) return RollupCell();
+        auto sem = dept->second.find(semester);
+        if (sem == dept->second.end()) return RollupCell();
+        auto sub = sem->second.find(subject);
+        return sub != sem->second.end() ? sub->second : RollupCell();
+    }
+};
+
+// Warm Start Class
+// warmstart.dat holds the parsed in-memory state - the student table, the attendance
+// bitmaps, exam results by student and the student accounts - so that startup does
+// not have to parse and replay the text files. Layout: an 8-byte magic, a CRC-32 of
+// the rest, then sections of [id][length][payload]. Each payload starts with a stamp
+// (size, modification time and a CRC-32 of the last 4 KB) of every file the section
+// was built from, and a section is only used while all of them still match. Anything
+// stale or missing is loaded from the files as before.
+class WarmStart {
+private:
+    static constexpr char FILE_MAGIC[9] = "SAMWRM02";
+    static const size_t TAIL_BYTES = 4096;
+
+    enum Section : uint32_t { STUDENTS = 1, ATTENDANCE = 2, EXAMS = 3, ACCOUNTS = 4 };
+
+    struct SourceStamp {
+        int64_t size;
+        int64_t modified;
+        uint32_t tailChecksum;
+
+        bool operator==(const SourceStamp& other) const {
+            return size == other.size && modified == other.modified && tailChecksum == other.tailChecksum;
+        }
+    };
+
+    map<uint32_t, string> current;      // payloads that matched their files, reused when saving
+    bool attempted;
+
+    WarmStart() : attempted(false) {}
+
+    static WarmStart& instance() {
+        static WarmStart warmStart;
+        return warmStart;
+    }
+
+    static vector<uint32_t> sections() {
+        return {STUDENTS, ATTENDANCE, EXAMS, ACCOUNTS};
+    }
+
+    static vector<string> sourcesOf(uint32_t section) {
+        switch (section) {
+            case STUDENTS: return {STUDENT_FILE, STUDENT_LOG_FILE};
+            case ATTENDANCE: return {ATTENDANCE_MANIFEST_FILE};
+            case EXAMS: return {EXAM_RESULTS_FILE};
+            default: return {STUDENT_ACCOUNTS_FILE};
+        }
+    }
+
+    static SourceStamp stampOf(const string& filename) {
+        SourceStamp stamp = {-1, 0, 0};
+        stamp.size = getFileSize(filename);
+        if (stamp.size < 0) return stamp;
+
+        error_code ec;
+        stamp.modified = static_cast<int64_t>(filesystem::last_write_time(filename, ec).time_since_epoch().count());
+
+        ifstream file(filename, ios::binary);
+        size_t tail = static_cast<size_t>(min<int64_t>(stamp.size, TAIL_BYTES));
+        string buffer(tail, '\0');
+        file.seekg(stamp.size - static_cast<int64_t>(tail));
+        file.read(&buffer[0], tail);
+        stamp.tailChecksum = crc32(buffer.data(), static_cast<size_t>(file.gcount()));
+        PerfCounters::add(PerfCounters::FILES_OPENED);
+        PerfCounters::add(PerfCounters::BYTES_READ, static_cast<uint64_t>(file.gcount()));
+        return stamp;
+    }
+
+    // Whether the stamps at the start of a payload still describe the files
+    static bool stampsMatch(BinaryReader& reader, uint32_t section) {
+        vector<string> sources = sourcesOf(section);
+        if (reader.read<uint32_t>() != sources.size()) return false;
+        for (const auto& source : sources) {
+            SourceStamp stamp;
+            stamp.size = reader.read<int64_t>();
+            stamp.modified = reader.read<int64_t>();
+            stamp.tailChecksum = reader.read<uint32_t>();
+            if (!reader.ok() || !(stamp == stampOf(source))) return false;
+        }
+        return true;
+    }
 
-public:
-    ExamResult() : rollNo(""), semester(""), subject(""), marks(0.0), grade(""), examType("") {}
-    ExamResult(string r, string s, string sub, double m, string g, string et) 
-        : rollNo(r), semester(s), subject(sub), marks(m), grade(g), examType(et) {}
+    static bool restore(uint32_t section, BinaryReader& reader) {
+        switch (section) {
+            case STUDENTS: return StudentRepository::loadWarmStart(reader);
+            case ATTENDANCE: return AttendanceIndex::loadWarmStart(reader);
+            case EXAMS: return ExamResultIndex::loadWarmStart(reader);
+            case ACCOUNTS: return StudentAccountStore::loadWarmStart(reader);
+        }
+        return false;
+    }
 
-    string getRollNo() const { return rollNo; }
-    string getSemester() const { return semester; }
-    string getSubject() const { return subject; }
-    double getMarks() const { return marks; }
-    string getGrade() const { return grade; }
-    string getExamType() const { return examType; }
+    // Builds a section from the live state; the stamps are taken afterwards because
+    // bringing the state up to date may itself touch the files (e.g. a conversion)
+    static string capture(uint32_t section) {
+        string data;
+        BinaryWriter writer(data);
+        switch (section) {
+            case STUDENTS: StudentRepository::saveWarmStart(writer); break;
+            case ATTENDANCE: AttendanceIndex::saveWarmStart(writer); break;
+            case EXAMS: ExamResultIndex::saveWarmStart(writer); break;
+            case ACCOUNTS: StudentAccountStore::saveWarmStart(writer); break;
+        }
 
-    void saveToFile(ofstream& file) const {
-        file << rollNo << "|" << semester << "|" << subject << "|" 
-             << fixed << setprecision(2) << marks << "|" << grade << "|" << examType << endl;
+        string payload;
+        BinaryWriter stamps(payload);
+        vector<string> sources = sourcesOf(section);
+        stamps.write<uint32_t>(static_cast<uint32_t>(sources.size()));
+        for (const auto& source : sources) {
+            SourceStamp stamp = stampOf(source);
+            stamps.write<int64_t>(stamp.size);
+            stamps.write<int64_t>(stamp.modified);
+            stamps.write<uint32_t>(stamp.tailChecksum);
+        }
+        return payload + data;
     }
 
-    bool loadFromFile(ifstream& file) {
-        string line;
-        if (getline(file, line)) {
-            stringstream ss(line);
-            string token;
-            
-            getline(ss, rollNo, '|');
-            getline(ss, semester, '|');
-            getline(ss, subject, '|');
-            
-            getline(ss, token, '|');
-            try {
-                marks = stod(token);
-            } catch (...) {
-                marks = 0.0;
+public:
+    // Restores every section that is still current; called once at startup
+    static void load() {
+        WarmStart& warmStart = instance();
+        if (warmStart.attempted) return;
+        warmStart.attempted = true;
+
+        MappedFile file(WARM_START_FILE);
+        if (file.size() < 12 || memcmp(file.begin(), FILE_MAGIC, 8) != 0) return;
+
+        uint32_t checksum;
+        memcpy(&checksum, file.begin() + 8, 4);
+        if (crc32(file.begin() + 12, file.size() - 12) != checksum) return;
+
+        BinaryReader reader(file.begin() + 12, file.size() - 12);
+        while (reader.ok() && reader.position() < file.size() - 12) {
+            uint32_t section = reader.read<uint32_t>();
+            uint32_t length = reader.read<uint32_t>();
+            size_t start = reader.position();
+            if (!reader.ok() || file.size() - 12 - start < length) break;
+
+            // A section whose files match is kept for the next save even when the class
+            // declines it (e.g. a store that has yet to be converted); it loads as usual
+            const char* payload = file.begin() + 12 + start;
+            BinaryReader sectionReader(payload, length);
+            if (stampsMatch(sectionReader, section)) {
+                restore(section, sectionReader);
+                warmStart.current[section] = string(payload, length);
             }
-            
-            getline(ss, grade, '|');
-            getline(ss, examType, '|');
-            
-            return true;
+            reader.skip(length);
         }
-        return false;
     }
 
-    static string calculateGrade(double marks) {
-        if (marks >= 90) return "A+";
-        else if (marks >= 80) return "A";
-        else if (marks >= 70) return "B+";
-        else if (marks >= 60) return "B";
-        else if (marks >= 50) return "C";
-        else if (marks >= 40) return "D";
-        else return "F";
+    // Rewrites warmstart.dat if any section no longer matches its files
+    static bool save() {
+        WarmStart& warmStart = instance();
+        bool changed = getFileSize(WARM_START_FILE) < 0;
+
+        for (uint32_t section : sections()) {
+            auto it = warmStart.current.find(section);
+            if (it != warmStart.current.end()) {
+                BinaryReader reader(it->second.data(), it->second.size());
+                if (stampsMatch(reader, section)) continue;
+            }
+            warmStart.current[section] = capture(section);
+            changed = true;
+        }
+        if (!changed) return true;
+
+        string body;
+        BinaryWriter writer(body);
+        for (const auto& section : warmStart.current) {
+            writer.write<uint32_t>(section.first);
+            writer.write<uint32_t>(static_cast<uint32_t>(section.second.size()));
+            body += section.second;
+        }
+
+        string data(FILE_MAGIC, 8);
+        BinaryWriter header(data);
+        header.write<uint32_t>(crc32(body.data(), body.size()));
+        return writeFileAtomically(WARM_START_FILE, data + body);
     }
 };
 
-// Attendance Class
-class Attendance {
+// Worker Pool Class
+// A fixed set of threads shared by the report generators. parallelFor() hands task
+// indices out through an atomic counter; the calling thread takes tasks too and
+// returns once all of them have finished. Tasks must not call parallelFor themselves.
+class WorkerPool {
 private:
-    string rollNo;
-    string date;
-    string status;
-    string subject;
+    vector<thread> threads;
+    mutex lock;
+    condition_variable wake;
+    condition_variable finished;
+    const function<void(size_t)>* job;
+    size_t taskCount;
+    atomic<size_t> nextTask;
+    size_t busyWorkers;
+    unsigned long long jobNumber;
+    bool stopping;
+
+    WorkerPool() : job(nullptr), taskCount(0), nextTask(0), busyWorkers(0), jobNumber(0), stopping(false) {
+        start(max(1u, thread::hardware_concurrency()));
+    }
 
-public:
-    Attendance() : rollNo(""), date(""), status(""), subject("") {}
-    Attendance(string r, string d, string s, string sub = "") 
-        : rollNo(r), date(d), status(s), subject(sub) {}
+    ~WorkerPool() {
+        stop();
+    }
 
-    string getRollNo() const { return rollNo; }
-    string getDate() const { return date; }
-    string getStatus() const { return status; }
-    string getSubject() const { return subject; }
+    static WorkerPool& instance() {
+        static WorkerPool pool;
+        return pool;
+    }
 
-    void setRollNo(const string& r) { rollNo = r; }
-    void setDate(const string& d) { date = d; }
-    void setStatus(const string& s) { status = s; }
-    void setSubject(const string& sub) { subject = sub; }
+    // The caller counts as one of the threads, so count - 1 are spawned. New workers
+    // start from the current job number so that they wait for the next job instead of
+    // picking up one that finished before they existed.
+    void start(size_t count) {
+        unsigned long long current;
+        {
+            lock_guard<mutex> guard(lock);
+            current = jobNumber;
+        }
+        for (size_t i = 1; i < count; i++) {
+            threads.emplace_back([this, current]() { workerLoop(current); });
+        }
+    }
 
-    void saveToFile(ofstream& file) const {
-        file << rollNo << "|" << date << "|" << status << "|" << subject << endl;
+    void stop() {
+        {
+            lock_guard<mutex> guard(lock);
+            stopping = true;
+        }
+        wake.notify_all();
+        for (auto& worker : threads) worker.join();
+        threads.clear();
+        stopping = false;
+        job = nullptr;
     }
 
-    bool loadFromFile(ifstream& file) {
-        string line;
-        if (getline(file, line)) {
-            stringstream ss(line);
-            getline(ss, rollNo, '|');
-            getline(ss, date, '|');
-            getline(ss, status, '|');
-            getline(ss, subject, '|');
-            return true;
+    void runTasks(const function<void(size_t)>& task, size_t count) {
+        size_t index;
+        while ((index = nextTask.fetch_add(1)) < count) {
+            task(index);
         }
-        return false;
     }
 
-    static double calculateAttendancePercentage(const string& rollNo, const string& subject = "") {
-        ifstream file(ATTENDANCE_FILE);
-        if (!file) return 0.0;
+    void workerLoop(unsigned long long seen) {
+        unique_lock<mutex> guard(lock);
+        while (true) {
+            wake.wait(guard, [&]() { return stopping || jobNumber != seen; });
+            if (stopping) return;
+            seen = jobNumber;
 
-        int totalDays = 0;
-        int presentDays = 0;
-        Attendance record;
+            const function<void(size_t)>& task = *job;
+            size_t count = taskCount;
+            guard.unlock();
+            runTasks(task, count);
+            guard.lock();
 
-        while (record.loadFromFile(file)) {
-            if (record.getRollNo() == rollNo && 
-                (subject.empty() || record.getSubject() == subject)) {
-                totalDays++;
-                if (record.getStatus() == "P") {
-                    presentDays++;
-                }
-            }
+            if (--busyWorkers == 0) finished.notify_all();
         }
-        file.close();
-
-        return totalDays > 0 ? (static_cast<double>(presentDays) / totalDays) * 100 : 0.0;
     }
 
-    static vector<string> getAvailableDates() {
-        vector<string> dates;
-        ifstream file(ATTENDANCE_FILE);
-        if (!file) return dates;
+public:
+    static size_t threadCount() {
+        return instance().threads.size() + 1;
+    }
 
-        Attendance record;
-        while (record.loadFromFile(file)) {
-            if (find(dates.begin(), dates.end(), record.getDate()) == dates.end()) {
-                dates.push_back(record.getDate());
-            }
-        }
-        file.close();
-        
-        sort(dates.begin(), dates.end());
-        return dates;
+    // Resizes the pool; only call while no parallelFor is running
+    static void setThreadCount(size_t count) {
+        WorkerPool& pool = instance();
+        pool.stop();
+        pool.start(max<size_t>(1, count));
     }
 
-    static vector<string> getSubjectsForStudent(const string& rollNo) {
-        vector<string> subjects;
-        ifstream file(ATTENDANCE_FILE);
-        if (!file) return subjects;
+    // Runs task(0) .. task(count - 1) across the pool and waits for all of them
+    static void parallelFor(size_t count, const function<void(size_t)>& task) {
+        WorkerPool& pool = instance();
+        if (pool.threads.empty() || count <= 1) {
+            for (size_t i = 0; i < count; i++) task(i);
+            return;
+        }
 
-        Attendance record;
-        while (record.loadFromFile(file)) {
-            if (record.getRollNo() == rollNo && !record.getSubject().empty() &&
-                find(subjects.begin(), subjects.end(), record.getSubject()) == subjects.end()) {
-                subjects.push_back(record.getSubject());
-            }
+        {
+            lock_guard<mutex> guard(pool.lock);
+            pool.job = &task;
+            pool.taskCount = count;
+            pool.nextTask = 0;
+            pool.busyWorkers = pool.threads.size();
+            pool.jobNumber++;
         }
-        file.close();
-        return subjects;
+        pool.wake.notify_all();
+
+        pool.runTasks(task, count);
+
+        unique_lock<mutex> guard(pool.lock);
+        pool.finished.wait(guard, [&]() { return pool.busyWorkers == 0; });
     }
 };
 
 // Report Generator Class
 class ReportGenerator {
 private:
+    static string& lastReportFile() {
+        static string filename;
+        return filename;
+    }
+
     static map<string, int> getAttendanceStats(const string& rollNo, const string& subject = "") {
-        map<string, int> stats = {{"total", 0}, {"present", 0}, {"absent", 0}};
-        
-        ifstream file(ATTENDANCE_FILE);
-        if (!file) return stats;
-        
-        Attendance record;
-        while (record.loadFromFile(file)) {
-            if (record.getRollNo() == rollNo && 
-                (subject.empty() || record.getSubject() == subject)) {
-                stats["total"]++;
-                if (record.getStatus() == "P") {
-                    stats["present"]++;
-                } else {
-                    stats["absent"]++;
-                }
-            }
-        }
-        file.close();
-        
-        return stats;
+        AttendanceCounter counter = AttendanceIndex::lookup(rollNo, subject);
+        return {{"total", counter.total}, {"present", counter.present}, {"absent", counter.total - counter.present}};
     }
     
     static map<string, string> loadStudentNames() {
         map<string, string> studentNames;
-        ifstream file(STUDENT_FILE);
-        if (!file) return studentNames;
-        
-        Student student;
-        while (student.loadFromFile(file)) {
+        for (const auto& student : StudentRepository::all()) {
             studentNames[student.getRollNo()] = student.getName();
         }
-        file.close();
         
         return studentNames;
     }
 
+    // Formats items [0, count) as contiguous shards on the worker pool and returns the
+    // shard outputs concatenated in order. format(begin, end, out) writes one shard.
+    template<typename Formatter>
+    static string renderSharded(size_t count, size_t minShardSize, const Formatter& format) {
+        size_t shards = max<size_t>(1, min(WorkerPool::threadCount() * 2, count / minShardSize));
+        vector<string> chunks(shards);
+        WorkerPool::parallelFor(shards, [&](size_t shard) {
+            ostringstream out;
+            format(count * shard / shards, count * (shard + 1) / shards, out);
+            chunks[shard] = out.str();
+        });
+
+        size_t total = 0;
+        for (const auto& chunk : chunks) total += chunk.size();
+        string merged;
+        merged.reserve(total);
+        for (const auto& chunk : chunks) merged += chunk;
+        return merged;
+    }
+
+    static const char* studentReportHeader() {
+        return "Roll No,Name,Department,Semester,Total Days,Present Days,Absent Days,Attendance %,Status\n";
+    }
+
+    static const char* departmentReportHeader() {
+        return "Department,Total Students,Average Attendance %,Good Attendance (>75%),Average Attendance (50-75%),Poor Attendance (<50%)\n";
+    }
+
+    static const char* dailyReportHeader() {
+        return "Roll No,Name,Date,Status,Subject\n";
+    }
+
+    static void writeStudentRow(ostream& out, const Student& student, const AttendanceCounter& counter) {
+        int totalDays = counter.total;
+        int presentDays = counter.present;
+        int absentDays = totalDays - presentDays;
+        double percentage = (totalDays > 0) ? (static_cast<double>(presentDays) / totalDays) * 100 : 0.0;
+        
+        string status;
+        if (percentage >= 75) status = "Good";
+        else if (percentage >= 50) status = "Average";
+        else status = "Poor";
+        
+        out << student.getRollNo() << ","
+            << "\"" << student.getName() << "\","
+            << "\"" << student.getDepartment() << "\","
+            << student.getSemester() << ","
+            << totalDays << ","
+            << presentDays << ","
+            << absentDays << ","
+            << fixed << setprecision(2) << percentage << "%,"
+            << status << "\n";
+    }
+
+    static void writeDepartmentRow(ostream& out, const string& department, const RollupCell& cell) {
+        double avgPercentage = cell.percentageSum / cell.headcount;
+        
+        out << "\"" << department << "\","
+            << cell.headcount << ","
+            << fixed << setprecision(2) << avgPercentage << "%,"
+            << cell.good << ","
+            << cell.average << ","
+            << cell.poor << "\n";
+    }
+
+    static void writeDailyRow(ostream& out, const AttendanceColumns& columns, size_t i,
+                              const map<string, string>& studentNames) {
+        const string& rollNo = columns.rollAt(i);
+        auto name = studentNames.find(rollNo);
+        string studentName = (name == studentNames.end() || name->second.empty()) ? "Unknown" : name->second;
+        
+        out << rollNo << ","
+            << "\"" << studentName << "\","
+            << daysToDate(columns.days[i]) << ","
+            << (columns.isPresent(i) ? "Present" : "Absent") << ","
+            << columns.subjectAt(i) << "\n";
+    }
+
+    static void writeMonthlyReport(ostream& outFile, const AttendanceColumns& columns, const vector<size_t>& rows) {
+        outFile << "Date,Status,Subject,Remarks\n";
+        
+        int presentDays = 0, totalDays = 0;
+        for (size_t i : rows) {
+            bool present = columns.isPresent(i);
+            string status = present ? "Present" : "Absent";
+            string remarks = present ? "Attended" : "Absent";
+            
+            outFile << daysToDate(columns.days[i]) << "," << status << "," << columns.subjectAt(i) << "," << remarks << "\n";
+            
+            totalDays++;
+            if (present) presentDays++;
+        }
+        
+        outFile << "\nSummary\n";
+        outFile << "Total Days," << totalDays << "\n";
+        outFile << "Present Days," << presentDays << "\n";
+        outFile << "Absent Days," << (totalDays - presentDays) << "\n";
+        outFile << "Attendance %," << fixed << setprecision(2) 
+               << (totalDays > 0 ? (static_cast<double>(presentDays) / totalDays) * 100 : 0) << "%\n";
+    }
+
 public:
+    // Name of the most recently generated report file
+    static string getLastReportFile() {
+        return lastReportFile();
+    }
+
     static bool generateAttendanceReportCSV(const vector<Student>& students, const string& reportType = "full") {
+        PerfScope scope("report." + reportType);
         string filename = "attendance_report_" + getCurrentDateTime() + ".csv";
+        lastReportFile() = filename;
         ofstream file(filename);
         
         if (!file) {
             return false;
         }
         
-        file << "Roll No,Name,Department,Semester,Total Days,Present Days,Absent Days,Attendance %,Status\n";
+        file << studentReportHeader();
         
-        for (const auto& student : students) {
-            map<string, int> attendanceStats = getAttendanceStats(student.getRollNo());
-            int totalDays = attendanceStats["total"];
-            int presentDays = attendanceStats["present"];
-            int absentDays = attendanceStats["absent"];
-            double percentage = (totalDays > 0) ? (static_cast<double>(presentDays) / totalDays) * 100 : 0.0;
-            
-            string status;
-            if (percentage >= 75) status = "Good";
-            else if (percentage >= 50) status = "Average";
-            else status = "Poor";
-            
-            file << student.getRollNo() << ","
-                 << "\"" << student.getName() << "\","
-                 << "\"" << student.getDepartment() << "\","
-                 << student.getSemester() << ","
-                 << totalDays << ","
-                 << presentDays << ","
-                 << absentDays << ","
-                 << fixed << setprecision(2) << percentage << "%,"
-                 << status << "\n";
-        }
+        // Counters for the whole list come from one sweep over the index bitmaps; the rows
+        // are then formatted shard by shard on the worker pool
+        vector<AttendanceCounter> totals = AttendanceIndex::totalsFor(students);
+        
+        file << renderSharded(students.size(), 256, [&](size_t begin, size_t end, ostream& out) {
+            for (size_t i = begin; i < end; i++) {
+                writeStudentRow(out, students[i], totals[i]);
+            }
+        });
         
         file.close();
         return true;
     }
     
     static bool generateDailyAttendanceReportCSV(const string& date) {
-        ifstream file(ATTENDANCE_FILE);
-        if (!file) return false;
+        PerfScope scope("report.daily");
+        bool allDates = date == "all";
+        int day = allDates ? INVALID_DAY : dateToDays(date);
+        if (!allDates && day == INVALID_DAY) return false;
+        
+        // One day reads only its month's segment; days outside every segment read nothing
+        AttendanceColumns dayColumns;
+        if (!allDates && !AttendanceStore::readRange(day, day, dayColumns)) return false;
+        const AttendanceColumns& columns = allDates ? AttendanceStore::getColumns() : dayColumns;
+        size_t scanEnd = columns.size();
         
         string filename = "daily_attendance_" + date + "_" + getCurrentDateTime() + ".csv";
+        lastReportFile() = filename;
         ofstream outFile(filename);
         
         if (!outFile) return false;
         
-        outFile << "Roll No,Name,Date,Status,Subject\n";
+        outFile << dailyReportHeader();
         
-        Attendance record;
-        map<string, string> studentNames = loadStudentNames();
+        const map<string, string> studentNames = loadStudentNames();
         
-        while (record.loadFromFile(file)) {
-            if (record.getDate() == date || date == "all") {
-                string studentName = studentNames[record.getRollNo()];
-                if (studentName.empty()) studentName = "Unknown";
-                
-                outFile << record.getRollNo() << ","
-                       << "\"" << studentName << "\","
-                       << record.getDate() << ","
-                       << (record.getStatus() == "P" ? "Present" : "Absent") << ","
-                       << record.getSubject() << "\n";
+        // Each shard filters and formats its own slice of the store
+        outFile << renderSharded(scanEnd, 4096, [&](size_t begin, size_t end, ostream& out) {
+            size_t matched = 0;
+            for (size_t i = begin; i < end; i++) {
+                if (allDates || columns.days[i] == day) {
+                    writeDailyRow(out, columns, i, studentNames);
+                    matched++;
+                }
             }
-        }
+            PerfCounters::add(PerfCounters::RECORDS_MATCHED, matched);
+        });
         
-        file.close();
         outFile.close();
         return true;
     }
     
-    static bool generateDepartmentReportCSV(const vector<Student>& students) {
+    static bool generateDepartmentReportCSV() {
+        PerfScope scope("report.department");
         string filename = "department_report_" + getCurrentDateTime() + ".csv";
+        lastReportFile() = filename;
         ofstream file(filename);
         
         if (!file) return false;
         
-        file << "Department,Total Students,Average Attendance %,Good Attendance (>75%),Average Attendance (50-75%),Poor Attendance (<50%)\n";
+        file << departmentReportHeader();
         
-        map<string, vector<double>> deptAttendance;
+        DepartmentRollup::ensure();
         
-        for (const auto& student : students) {
-            double percentage = Attendance::calculateAttendancePercentage(student.getRollNo());
-            deptAttendance[student.getDepartment()].push_back(percentage);
+        map<string, RollupCell> byDepartment = DepartmentRollup::byDepartment();
+        vector<pair<string, RollupCell>> departments(byDepartment.begin(), byDepartment.end());
+        
+        file << renderSharded(departments.size(), 16, [&](size_t begin, size_t end, ostream& out) {
+            for (size_t i = begin; i < end; i++) {
+                if (departments[i].second.headcount > 0) writeDepartmentRow(out, departments[i].first, departments[i].second);
+            }
+        });
+        
+        file.close();
+        return true;
+    }
+    
+    // Comprehensive, department and all-dates daily reports from one shared pass over
+    // the attendance store. The pass gathers per-student counters and a date-ordered
+    // row list; the three files are then written in parallel from those aggregates.
+    static bool generateReportBundle(const vector<Student>& students, vector<string>& files) {
+        PerfScope scope("report.bundle");
+        const AttendanceColumns& columns = AttendanceStore::getColumns();
+        size_t count = columns.size();
+        
+        int firstDay = INT_MAX, lastDay = INT_MIN;
+        for (size_t i = 0; i < count; i++) {
+            firstDay = min(firstDay, columns.days[i]);
+            lastDay = max(lastDay, columns.days[i]);
+        }
+        
+        // Stable counting sort by day, so records of one day keep their store order
+        vector<size_t> byDate(count);
+        size_t daySpan = count > 0 ? static_cast<size_t>(static_cast<int64_t>(lastDay) - firstDay) + 1 : 0;
+        if (daySpan <= count * 4 + 1024) {
+            vector<size_t> offsets(daySpan + 1, 0);
+            for (size_t i = 0; i < count; i++) offsets[columns.days[i] - firstDay + 1]++;
+            for (size_t d = 1; d <= daySpan; d++) offsets[d] += offsets[d - 1];
+            for (size_t i = 0; i < count; i++) byDate[offsets[columns.days[i] - firstDay]++] = i;
+        } else {
+            for (size_t i = 0; i < count; i++) byDate[i] = i;
+            stable_sort(byDate.begin(), byDate.end(), [&](size_t a, size_t b) { return columns.days[a] < columns.days[b]; });
         }
         
-        for (const auto& dept : deptAttendance) {
-            double totalPercentage = 0;
-            int goodCount = 0, avgCount = 0, poorCount = 0;
-            int totalStudents = dept.second.size();
+        vector<AttendanceCounter> studentTotals = AttendanceIndex::totalsFor(students);
+        map<string, RollupCell> departments;
+        map<string, string> studentNames;
+        for (size_t k = 0; k < students.size(); k++) {
+            const Student& student = students[k];
+            studentNames[student.getRollNo()] = student.getName();
             
-            for (double percentage : dept.second) {
-                totalPercentage += percentage;
-                if (percentage >= 75) goodCount++;
-                else if (percentage >= 50) avgCount++;
-                else poorCount++;
+            const AttendanceCounter& counter = studentTotals[k];
+            double percentage = counter.total > 0 ? (static_cast<double>(counter.present) / counter.total) * 100 : 0.0;
+            RollupCell& cell = departments[student.getDepartment()];
+            cell.headcount++;
+            cell.present += counter.present;
+            cell.total += counter.total;
+            cell.percentageSum += percentage;
+            if (percentage >= 75) cell.good++;
+            else if (percentage >= 50) cell.average++;
+            else cell.poor++;
+        }
+        
+        string stamp = getCurrentDateTime();
+        files = {"attendance_report_" + stamp + ".csv",
+                 "department_report_" + stamp + ".csv",
+                 "daily_attendance_all_" + stamp + ".csv"};
+        
+        atomic<bool> ok(true);
+        WorkerPool::parallelFor(files.size(), [&](size_t report) {
+            ofstream out(files[report]);
+            if (!out) {
+                ok = false;
+                return;
             }
             
-            double avgPercentage = totalStudents > 0 ? totalPercentage / totalStudents : 0;
-            
-            file << "\"" << dept.first << "\","
-                 << totalStudents << ","
-                 << fixed << setprecision(2) << avgPercentage << "%,"
-                 << goodCount << ","
-                 << avgCount << ","
-                 << poorCount << "\n";
-        }
+            if (report == 0) {
+                out << studentReportHeader();
+                for (size_t k = 0; k < students.size(); k++) writeStudentRow(out, students[k], studentTotals[k]);
+            } else if (report == 1) {
+                out << departmentReportHeader();
+                for (const auto& dept : departments) writeDepartmentRow(out, dept.first, dept.second);
+            } else {
+                out << dailyReportHeader();
+                for (size_t i : byDate) writeDailyRow(out, columns, i, studentNames);
+            }
+        });
         
-        file.close();
-        return true;
+        if (ok) lastReportFile() = files[0];
+        return ok;
     }
     
     static bool generateMonthlyReportCSV(const string& rollNo, const string& monthYear) {
-        ifstream file(ATTENDANCE_FILE);
-        if (!file) return false;
+        PerfScope scope("report.monthly");
         
         string filename = "monthly_report_" + rollNo + "_" + monthYear + "_" + getCurrentDateTime() + ".csv";
+        lastReportFile() = filename;
         ofstream outFile(filename);
         
         if (!outFile) return false;
         
-        outFile << "Date,Status,Subject,Remarks\n";
-        
-        Attendance record;
-        int presentDays = 0, totalDays = 0;
+        // Only the month's own segment is read
+        int firstDay = 0, lastDay = -1;
+        AttendanceColumns columns;
+        if (monthToDayRange(monthYear, firstDay, lastDay) && !AttendanceStore::readRange(firstDay, lastDay, columns)) {
+            return false;
+        }
+        auto rollId = columns.rollIds.find(rollNo);
+        bool hasRecords = rollId != columns.rollIds.end();
         
-        while (record.loadFromFile(file)) {
-            if (record.getRollNo() == rollNo && record.getDate().substr(0, 7) == monthYear) {
-                string status = (record.getStatus() == "P") ? "Present" : "Absent";
-                string remarks = (record.getStatus() == "P") ? "Attended" : "Absent";
-                
-                outFile << record.getDate() << "," << status << "," << record.getSubject() << "," << remarks << "\n";
-                
-                totalDays++;
-                if (record.getStatus() == "P") presentDays++;
+        vector<size_t> rows;
+        for (size_t i = 0; hasRecords && i < columns.size(); i++) {
+            if (columns.rolls[i] == rollId->second && columns.days[i] >= firstDay && columns.days[i] <= lastDay) {
+                rows.push_back(i);
             }
         }
+        PerfCounters::add(PerfCounters::RECORDS_MATCHED, rows.size());
         
-        outFile << "\nSummary\n";
-        outFile << "Total Days," << totalDays << "\n";
-        outFile << "Present Days," << presentDays << "\n";
-        outFile << "Absent Days," << (totalDays - presentDays) << "\n";
-        outFile << "Attendance %," << fixed << setprecision(2) 
-               << (totalDays > 0 ? (static_cast<double>(presentDays) / totalDays) * 100 : 0) << "%\n";
-        
-        file.close();
+        writeMonthlyReport(outFile, columns, rows);
         outFile.close();
         return true;
     }
+    
+    // Monthly reports for many students, written into a fresh directory. The month's
+    // segment is read once and its records bucketed by roll number; the per-student files
+    // are then written in parallel on the worker pool.
+    static bool generateMonthlyReportsCSV(const vector<string>& rollNos, const string& monthYear, string& directory) {
+        PerfScope scope("report.monthly-all");
+        int firstDay = 0, lastDay = -1;
+        if (!monthToDayRange(monthYear, firstDay, lastDay)) return false;
+        
+        AttendanceColumns columns;
+        if (!AttendanceStore::readRange(firstDay, lastDay, columns)) {
+            return false;
+        }
+        vector<vector<size_t>> rowsByRoll(columns.rollDict.size());
+        size_t matched = 0;
+        for (size_t i = 0; i < columns.size(); i++) {
+            if (columns.days[i] >= firstDay && columns.days[i] <= lastDay) {
+                rowsByRoll[columns.rolls[i]].push_back(i);
+                matched++;
+            }
+        }
+        PerfCounters::add(PerfCounters::RECORDS_MATCHED, matched);
+        
+        directory = "monthly_reports_" + monthYear + "_" + getCurrentDateTime();
+        error_code ec;
+        filesystem::create_directories(directory, ec);
+        if (ec) return false;
+        
+        static const vector<size_t> noRows;
+        size_t shards = max<size_t>(1, min(WorkerPool::threadCount() * 2, rollNos.size()));
+        atomic<bool> ok(true);
+        WorkerPool::parallelFor(shards, [&](size_t shard) {
+            size_t begin = rollNos.size() * shard / shards;
+            size_t end = rollNos.size() * (shard + 1) / shards;
+            for (size_t k = begin; k < end; k++) {
+                auto rollId = columns.rollIds.find(rollNos[k]);
+                const vector<size_t>& rows = rollId != columns.rollIds.end() ? rowsByRoll[rollId->second] : noRows;
+                
+                ofstream outFile(directory + "/monthly_report_" + rollNos[k] + "_" + monthYear + ".csv");
+                if (!outFile) {
+                    ok = false;
+                    continue;
+                }
+                writeMonthlyReport(outFile, columns, rows);
+            }
+        });
+        
+        if (ok) lastReportFile() = directory;
+        return ok;
+    }
 
     static bool generateStudentPerformanceReport(const string& rollNo) {
+        PerfScope scope("report.performance");
         vector<ExamResult> results = loadStudentExamResults(rollNo);
         if (results.empty()) return false;
 
         string filename = "student_performance_" + rollNo + "_" + getCurrentDateTime() + ".csv";
+        lastReportFile() = filename;
         ofstream file(filename);
         
         if (!file) return false;
 
-        file << "Semester,Subject,Exam Type,Marks,Grade\n";
-        
-        double totalMarks = 0;
-        int count = 0;
-        
+        file << "Semester,Subject,Exam Type,Marks,Grade\n";
+        
+        double totalMarks = 0;
+        int count = 0;
+        
+        for (const auto& result : results) {
+            file << result.getSemester() << ","
+                 << result.getSubject() << ","
+                 << result.getExamType() << ","
+                 << fixed << setprecision(2) << result.getMarks() << ","
+                 << result.getGrade() << "\n";
+            
+            totalMarks += result.getMarks();
+            count++;
+        }
+        
+        if (count > 0) {
+            file << "\nSummary\n";
+            file << "Total Subjects," << count << "\n";
+            file << "Average Marks," << fixed << setprecision(2) << (totalMarks / count) << "\n";
+            file << "Overall Grade," << ExamResult::calculateGrade(totalMarks / count) << "\n";
+        }
+        
+        file.close();
+        return true;
+    }
+
+    static vector<ExamResult> loadStudentExamResults(const string& rollNo) {
+        PerfScope scope("report.exam-results");
+        return ExamResultIndex::forStudent(rollNo);
+    }
+};
+
+// Import Summary - outcome of one bulk import
+struct ImportSummary {
+    bool opened = false;
+    size_t accepted = 0;
+    size_t rejected = 0;
+    bool committed = false;
+    string errorReport;     // CSV listing the rejected rows; empty when there were none
+    double seconds = 0.0;
+};
+
+// Bulk Importer Class
+// Loads students, attendance or exam results from a CSV file (or a '|'-separated file
+// in the data-file layout; a leading header row is skipped). The mapped file is cut
+// into line-aligned chunks that worker threads parse and validate in parallel. The
+// main thread then checks roll numbers against the student table in file order and
+// commits every accepted row as one batch.
+class BulkImporter {
+private:
+    static const size_t MIN_CHUNK_BYTES = 256 * 1024;
+
+    template<typename Record>
+    struct ParsedRow {
+        size_t line;            // line number within the chunk until the chunks are merged
+        string_view text;
+        Record record;
+        const char* error;
+    };
+
+    template<typename Record>
+    struct Chunk {
+        const char* begin;
+        const char* end;
+        size_t lines = 0;
+        vector<ParsedRow<Record>> rows;
+    };
+
+    // Splits one line into fields; quotes around a CSV field are dropped
+    static void splitFields(string_view line, char delimiter, vector<string_view>& fields) {
+        fields.clear();
+        size_t pos = 0;
+        while (true) {
+            size_t end;
+            if (delimiter == ',' && pos < line.size() && line[pos] == '"') {
+                size_t close = line.find('"', pos + 1);
+                if (close == string_view::npos) close = line.size();
+                fields.push_back(line.substr(pos + 1, close - pos - 1));
+                end = line.find(delimiter, close);
+            } else {
+                end = line.find(delimiter, pos);
+                fields.push_back(line.substr(pos, end == string_view::npos ? string_view::npos : end - pos));
+            }
+            if (end == string_view::npos) break;
+            pos = end + 1;
+        }
+    }
+
+    static bool parseWhole(string_view text, double& value) {
+        auto result = from_chars(text.data(), text.data() + text.size(), value);
+        return !text.empty() && result.ec == errc() && result.ptr == text.data() + text.size();
+    }
+
+    static const char* parseRecord(const vector<string_view>& fields, Student& student) {
+        if (fields.size() < 4) return "expected roll, name, department, semester[, email, phone]";
+        student.loadFromFields(fields);
+        if (!validateRollNo(student.getRollNo())) return "invalid roll number";
+        if (!validateName(student.getName())) return "invalid name";
+        if (student.getDepartment().empty()) return "missing department";
+        if (student.getSemester() <= 0) return "invalid semester";
+        if (!student.getEmail().empty() && !validateEmail(student.getEmail())) return "invalid email";
+        return nullptr;
+    }
+
+    static const char* parseRecord(const vector<string_view>& fields, Attendance& attendance) {
+        if (fields.size() < 3) return "expected roll, date, status[, subject]";
+        string_view status = fields[2];
+        if (status == "Present") status = "P";
+        else if (status == "Absent") status = "A";
+
+        attendance = Attendance(string(fields[0]), string(fields[1]), string(status), string(fieldAt(fields, 3)));
+        if (!validateRollNo(attendance.getRollNo())) return "invalid roll number";
+        int day = dateToDays(attendance.getDate());
+        if (day == INVALID_DAY || daysToDate(day) != attendance.getDate()) return "invalid date";
+        if (status != "P" && status != "A") return "status must be P or A";
+        return nullptr;
+    }
+
+    static const char* parseRecord(const vector<string_view>& fields, ExamResult& result) {
+        if (fields.size() < 5) return "expected roll, semester, subject, marks, exam type";
+        double marks;
+        if (!parseWhole(fields[3], marks) || marks < 0 || marks > 100) return "marks must be 0-100";
+
+        result = ExamResult(string(fields[0]), string(fields[1]), string(fields[2]), marks,
+                            ExamResult::calculateGrade(marks), string(fields[4]));
+        if (!validateRollNo(result.getRollNo())) return "invalid roll number";
+        if (result.getSemester().empty() || result.getSubject().empty()) return "missing semester or subject";
+        return nullptr;
+    }
+
+    template<typename Record>
+    static void parseChunk(Chunk<Record>& chunk, char delimiter, bool skipHeader) {
+        vector<string_view> fields;
+        const char* pos = chunk.begin;
+        while (pos < chunk.end) {
+            const char* newline = static_cast<const char*>(memchr(pos, '\n', chunk.end - pos));
+            const char* lineEnd = newline ? newline : chunk.end;
+            string_view line(pos, lineEnd - pos);
+            if (!line.empty() && line.back() == '\r') line.remove_suffix(1);
+            pos = newline ? newline + 1 : chunk.end;
+            chunk.lines++;
+
+            if (line.empty() || (skipHeader && chunk.lines == 1)) continue;
+            if (delimiter == ',' && line.find('|') != string_view::npos) {
+                chunk.rows.push_back({chunk.lines, line, Record(), "field contains '|'"});
+                continue;
+            }
+
+            splitFields(line, delimiter, fields);
+            ParsedRow<Record> row{chunk.lines, line, Record(), nullptr};
+            row.error = parseRecord(fields, row.record);
+            chunk.rows.push_back(row);
+        }
+    }
+
+    static string rollOf(const Student& student) { return student.getRollNo(); }
+    static string rollOf(const Attendance& attendance) { return attendance.getRollNo(); }
+    static string rollOf(const ExamResult& result) { return result.getRollNo(); }
+
+    static bool commit(const vector<Student>& students) {
+        return StudentRepository::addBatch(students);
+    }
+
+    static bool commit(const vector<Attendance>& records) {
+        AttendanceBatch batch;
+        for (const auto& record : records) {
+            batch.add(record.getRollNo(), record.getDate(), record.getStatus(), record.getSubject());
+        }
+        return batch.commit();
+    }
+
+    static bool commit(const vector<ExamResult>& results) {
+        ostringstream lines;
         for (const auto& result : results) {
-            file << result.getSemester() << ","
-                 << result.getSubject() << ","
-                 << result.getExamType() << ","
-                 << fixed << setprecision(2) << result.getMarks() << ","
-                 << result.getGrade() << "\n";
-            
-            totalMarks += result.getMarks();
-            count++;
+            result.saveToFile(lines);
         }
-        
-        if (count > 0) {
-            file << "\nSummary\n";
-            file << "Total Subjects," << count << "\n";
-            file << "Average Marks," << fixed << setprecision(2) << (totalMarks / count) << "\n";
-            file << "Overall Grade," << ExamResult::calculateGrade(totalMarks / count) << "\n";
+        return appendDurably(EXAM_RESULTS_FILE, lines.str());
+    }
+
+    static string csvQuote(string_view text) {
+        string quoted = "\"";
+        for (char c : text) {
+            if (c == '"') quoted += '"';
+            quoted += c;
         }
-        
-        file.close();
-        return true;
+        return quoted + "\"";
     }
 
-    static vector<ExamResult> loadStudentExamResults(const string& rollNo) {
-        vector<ExamResult> results;
-        ifstream file(EXAM_RESULTS_FILE);
-        if (!file) return results;
+    template<typename Record>
+    static ImportSummary importFile(const string& filename, const string& kind, bool newStudents) {
+        auto started = chrono::steady_clock::now();
+        ImportSummary summary;
+
+        MappedFile file(filename);
+        if (!file.isOpen()) return summary;
+        summary.opened = true;
+
+        const char* data = file.begin();
+        size_t size = file.size();
+        string_view firstLine(data, size);
+        firstLine = firstLine.substr(0, firstLine.find('\n'));
+        char delimiter = firstLine.find('|') != string_view::npos ? '|' : ',';
+        vector<string_view> fields;
+        splitFields(firstLine, delimiter, fields);
+        bool skipHeader = !fields.empty() && !validateRollNo(string(fields[0]));
+
+        // Line-aligned chunks, one per worker
+        size_t workers = max<size_t>(1, min<size_t>(thread::hardware_concurrency(), size / MIN_CHUNK_BYTES + 1));
+        vector<Chunk<Record>> chunks;
+        const char* pos = data;
+        const char* end = data + size;
+        for (size_t i = 0; i < workers && pos < end; i++) {
+            const char* chunkEnd = (i + 1 == workers) ? end : data + size * (i + 1) / workers;
+            if (chunkEnd < pos) chunkEnd = pos;
+            const char* newline = static_cast<const char*>(memchr(chunkEnd, '\n', end - chunkEnd));
+            chunkEnd = newline ? newline + 1 : end;
+            chunks.push_back({pos, chunkEnd, 0, {}});
+            pos = chunkEnd;
+        }
 
-        ExamResult result;
-        while (result.loadFromFile(file)) {
-            if (result.getRollNo() == rollNo) {
-                results.push_back(result);
+        vector<thread> threads;
+        for (size_t i = 1; i < chunks.size(); i++) {
+            threads.emplace_back(parseChunk<Record>, ref(chunks[i]), delimiter, false);
+        }
+        if (!chunks.empty()) parseChunk(chunks[0], delimiter, skipHeader);
+        for (auto& worker : threads) worker.join();
+
+        // Merge in file order: roll numbers are checked against the student table here
+        vector<string> rollNos;
+        for (const auto& chunk : chunks) {
+            for (const auto& row : chunk.rows) {
+                if (!row.error) rollNos.push_back(rollOf(row.record));
             }
         }
-        file.close();
-        return results;
+        vector<bool> known = StudentRepository::existing(rollNos);
+
+        vector<Record> accepted;
+        accepted.reserve(rollNos.size());
+        string errors;
+        unordered_set<string> seenRolls;
+        size_t lineOffset = 0, checked = 0;
+        for (auto& chunk : chunks) {
+            for (auto& row : chunk.rows) {
+                const char* error = row.error;
+                if (!error) {
+                    size_t k = checked++;
+                    if (newStudents) {
+                        if (known[k]) error = "roll number already exists";
+                        else if (!seenRolls.insert(rollNos[k]).second) error = "duplicate roll number in file";
+                    } else if (!known[k]) {
+                        error = "unknown roll number";
+                    }
+                }
+
+                if (error) {
+                    errors += to_string(lineOffset + row.line) + "," + csvQuote(error) + "," + csvQuote(row.text) + "\n";
+                    summary.rejected++;
+                } else {
+                    accepted.push_back(move(row.record));
+                }
+            }
+            lineOffset += chunk.lines;
+        }
+
+        summary.accepted = accepted.size();
+        PerfCounters::add(PerfCounters::RECORDS_MATCHED, accepted.size());
+        summary.committed = accepted.empty() || commit(accepted);
+
+        if (!errors.empty()) {
+            summary.errorReport = "import_errors_" + kind + "_" + getCurrentDateTime() + ".csv";
+            ofstream report(summary.errorReport);
+            report << "Line,Error,Record\n" << errors;
+        }
+
+        summary.seconds = chrono::duration<double>(chrono::steady_clock::now() - started).count();
+        return summary;
+    }
+
+public:
+    static ImportSummary importStudents(const string& filename) {
+        return importFile<Student>(filename, "students", true);
+    }
+
+    static ImportSummary importAttendance(const string& filename) {
+        return importFile<Attendance>(filename, "attendance", false);
+    }
+
+    static ImportSummary importExamResults(const string& filename) {
+        return importFile<ExamResult>(filename, "exams", false);
     }
 };
 
@@ -716,7 +5517,7 @@ public:
     int display() {
         int key;
         do {
-            system("cls");
+            clearScreen();
             
             drawBox(boxX, boxY, boxWidth, boxHeight, title);
             
@@ -732,10 +5533,10 @@ public:
                 }
             }
             
-            key = _getch();
+            key = readKey();
             
             if (key == 224) {
-                key = _getch();
+                key = readKey();
                 switch (key) {
                     case 72:
                         currentSelection = (currentSelection - 1 + options.size()) % options.size();
@@ -790,7 +5591,7 @@ public:
 class PasswordManager {
 public:
     bool changePassword(Person* user, const string& userType) {
-        system("cls");
+        clearScreen();
         drawBox(20, 5, 40, 10, "CHANGE PASSWORD");
         
         string oldPass, newPass, confirmPass;
@@ -799,7 +5600,7 @@ public:
         cout << "Current Password: ";
         string hiddenPass = "";
         char ch;
-        while ((ch = _getch()) != 13) {
+        while ((ch = readKey()) != 13) {
             if (ch == 8) {
                 if (!hiddenPass.empty()) {
                     hiddenPass.pop_back();
@@ -821,7 +5622,7 @@ public:
         gotoxy(22, 8);
         cout << "New Password: ";
         hiddenPass = "";
-        while ((ch = _getch()) != 13) {
+        while ((ch = readKey()) != 13) {
             if (ch == 8) {
                 if (!hiddenPass.empty()) {
                     hiddenPass.pop_back();
@@ -838,7 +5639,7 @@ public:
         gotoxy(22, 9);
         cout << "Confirm Password: ";
         hiddenPass = "";
-        while ((ch = _getch()) != 13) {
+        while ((ch = readKey()) != 13) {
             if (ch == 8) {
                 if (!hiddenPass.empty()) {
                     hiddenPass.pop_back();
@@ -891,7 +5692,7 @@ public:
     }
     
     void showNotifications() {
-        system("cls");
+        clearScreen();
         drawBox(10, 2, 60, 10, "NOTIFICATIONS");
         
         if (notifications.empty()) {
@@ -906,7 +5707,7 @@ public:
         
         gotoxy(12, 12);
         cout << "Press any key to continue...";
-        _getch();
+        readKey();
     }
 };
 
@@ -917,7 +5718,7 @@ private:
     PasswordManager passwordManager;
 
     bool studentLogin() {
-        system("cls");
+        clearScreen();
         drawBox(20, 5, 40, 10, "STUDENT LOGIN");
         
         string inputUsername, inputPassword;
@@ -930,7 +5731,7 @@ private:
         cout << "Password: ";
         string hiddenPass = "";
         char ch;
-        while ((ch = _getch()) != 13) {
+        while ((ch = readKey()) != 13) {
             if (ch == 8) {
                 if (!hiddenPass.empty()) {
                     hiddenPass.pop_back();
@@ -944,29 +5745,18 @@ private:
         inputPassword = hiddenPass;
         cout << endl;
 
-        ifstream file(STUDENT_CREDENTIALS_FILE);
-        if (!file) {
+        if (StudentAccountStore::count() == 0) {
             displayMessageBox("No student accounts found! Please sign up first.", true);
             return false;
         }
 
-        string storedUsername, storedPassword, storedRollNo, storedName;
-        bool found = false;
-
-        while (getline(file, storedUsername) && getline(file, storedPassword) && 
-               getline(file, storedRollNo) && getline(file, storedName)) {
-            if (inputUsername == storedUsername && encryptDecrypt(storedPassword) == inputPassword) {
-                username = storedUsername;
-                password = storedPassword;
-                rollNo = storedRollNo;
-                name = storedName;
-                found = true;
-                break;
-            }
-        }
-        file.close();
+        StudentAccount account;
+        if (StudentAccountStore::authenticate(inputUsername, inputPassword, account)) {
+            username = account.username;
+            password = account.password;
+            rollNo = account.rollNo;
+            name = account.name;
 
-        if (found) {
             gotoxy(25, 10);
             setColor(COLOR_GREEN);
             cout << "Login successful!";
@@ -984,7 +5774,7 @@ private:
     }
 
     bool studentSignup() {
-        system("cls");
+        clearScreen();
         drawBox(15, 3, 50, 16, "STUDENT SIGN UP");
 
         string newUsername, newPassword, confirmPassword, inputRollNo, inputName, inputEmail, inputPhone;
@@ -994,35 +5784,19 @@ private:
         cin >> inputRollNo;
         
         // Check if student exists in main database
-        ifstream studentFile(STUDENT_FILE);
-        bool studentExists = false;
-        Student tempStudent;
-        while (studentFile && tempStudent.loadFromFile(studentFile)) {
-            if (tempStudent.getRollNo() == inputRollNo) {
-                studentExists = true;
-                inputName = tempStudent.getName();
-                break;
-            }
-        }
-        studentFile.close();
-
-        if (!studentExists) {
+        Student student;
+        if (StudentRepository::find(inputRollNo, student)) {
+            inputName = student.getName();
+        } else {
             displayMessageBox("Student roll number not found in database! Contact admin.", true);
             return false;
         }
 
         // Check if account already exists
-        ifstream credFile(STUDENT_CREDENTIALS_FILE);
-        string existingUser, existingPass, existingRoll, existingName;
-        while (getline(credFile, existingUser) && getline(credFile, existingPass) && 
-               getline(credFile, existingRoll) && getline(credFile, existingName)) {
-            if (existingRoll == inputRollNo) {
-                displayMessageBox("Account already exists for this roll number!", true);
-                credFile.close();
-                return false;
-            }
+        if (StudentAccountStore::hasAccountFor(inputRollNo)) {
+            displayMessageBox("Account already exists for this roll number!", true);
+            return false;
         }
-        credFile.close();
 
         gotoxy(17, 6);
         cout << "Name: " << inputName;
@@ -1030,12 +5804,17 @@ private:
         gotoxy(17, 7);
         cout << "Username: ";
         cin >> newUsername;
+
+        if (StudentAccountStore::usernameTaken(newUsername)) {
+            displayMessageBox("Username already taken!", true);
+            return false;
+        }
         
         gotoxy(17, 8);
         cout << "Password: ";
         string hiddenPass = "";
         char ch;
-        while ((ch = _getch()) != 13) {
+        while ((ch = readKey()) != 13) {
             if (ch == 8) {
                 if (!hiddenPass.empty()) {
                     hiddenPass.pop_back();
@@ -1052,7 +5831,7 @@ private:
         gotoxy(17, 9);
         cout << "Confirm Password: ";
         hiddenPass = "";
-        while ((ch = _getch()) != 13) {
+        while ((ch = readKey()) != 13) {
             if (ch == 8) {
                 if (!hiddenPass.empty()) {
                     hiddenPass.pop_back();
@@ -1077,18 +5856,16 @@ private:
         }
 
         // Save credentials
-        ofstream file(STUDENT_CREDENTIALS_FILE, ios::app);
-        if (!file) {
+        StudentAccount account;
+        account.username = newUsername;
+        account.password = encryptDecrypt(newPassword);
+        account.rollNo = inputRollNo;
+        account.name = inputName;
+        if (!StudentAccountStore::create(account)) {
             displayMessageBox("Error creating account!", true);
             return false;
         }
 
-        file << newUsername << endl;
-        file << encryptDecrypt(newPassword) << endl;
-        file << inputRollNo << endl;
-        file << inputName << endl;
-        file.close();
-
         username = newUsername;
         password = encryptDecrypt(newPassword);
         rollNo = inputRollNo;
@@ -1099,16 +5876,9 @@ private:
     }
 
     Student getStudentInfo() {
-        ifstream file(STUDENT_FILE);
         Student student;
-        while (student.loadFromFile(file)) {
-            if (student.getRollNo() == rollNo) {
-                file.close();
-                return student;
-            }
-        }
-        file.close();
-        return Student();
+        StudentRepository::find(rollNo, student);
+        return student;
     }
 
     void viewAttendanceSummary() {
@@ -1118,7 +5888,7 @@ private:
             return;
         }
 
-        system("cls");
+        clearScreen();
         drawBox(10, 2, 60, 12, "ATTENDANCE SUMMARY - " + rollNo);
         
         gotoxy(12, 4);
@@ -1128,7 +5898,10 @@ private:
         gotoxy(12, 6);
         cout << "Semester: " << student.getSemester();
         
-        double overallPercentage = Attendance::calculateAttendancePercentage(rollNo);
+        // One read of the materialized counters; the store is only loaded if they are stale
+        AttendanceCounterFile::Summary summary = AttendanceCounterFile::forStudent(rollNo);
+        const AttendanceCounter& overall = summary.overall;
+        double overallPercentage = overall.total > 0 ? (static_cast<double>(overall.present) / overall.total) * 100 : 0.0;
         gotoxy(12, 8);
         cout << "Overall Attendance: ";
         if (overallPercentage >= 75) setColor(COLOR_GREEN);
@@ -1138,26 +5911,26 @@ private:
         setColor(COLOR_DEFAULT);
 
         // Subject-wise attendance
-        vector<string> subjects = Attendance::getSubjectsForStudent(rollNo);
-        if (!subjects.empty()) {
+        if (!summary.subjects.empty()) {
             gotoxy(12, 10);
             cout << "Subject-wise Attendance:";
             int line = 11;
-            for (const auto& subject : subjects) {
+            for (const auto& subject : summary.subjects) {
                 if (line > 20) break;
-                double subjectPercentage = Attendance::calculateAttendancePercentage(rollNo, subject);
+                const AttendanceCounter& counter = subject.second;
+                double subjectPercentage = counter.total > 0 ? (static_cast<double>(counter.present) / counter.total) * 100 : 0.0;
                 gotoxy(14, line++);
-                cout << subject << ": " << fixed << setprecision(2) << subjectPercentage << "%";
+                cout << subject.first << ": " << fixed << setprecision(2) << subjectPercentage << "%";
             }
         }
 
         gotoxy(12, 22);
         cout << "Press any key to continue...";
-        _getch();
+        readKey();
     }
 
     void viewDetailedAttendance() {
-        system("cls");
+        clearScreen();
         drawBox(10, 2, 65, 20, "DETAILED ATTENDANCE RECORD - " + rollNo);
         
         gotoxy(12, 4);
@@ -1167,24 +5940,14 @@ private:
         cout << "--------------|----------------|---------";
         setColor(COLOR_DEFAULT);
 
-        ifstream file(ATTENDANCE_FILE);
-        if (!file) {
-            setColor(COLOR_RED);
-            gotoxy(12, 4);
-            cout << "No attendance records found!";
-            setColor(COLOR_DEFAULT);
-            gotoxy(12, 6);
-            cout << "Press any key to continue...";
-            _getch();
-            return;
-        }
-
-        Attendance record;
+        const AttendanceColumns& columns = AttendanceStore::getColumns();
+        auto rollId = columns.rollIds.find(rollNo);
         bool found = false;
         int line = 6;
 
-        while (record.loadFromFile(file) && line < 18) {
-            if (record.getRollNo() == rollNo) {
+        for (size_t i = 0; rollId != columns.rollIds.end() && i < columns.size() && line < 18; i++) {
+            if (columns.rolls[i] == rollId->second) {
+                Attendance record = columns.record(i);
                 gotoxy(12, line++);
                 cout << setw(12) << left << record.getDate() 
                      << " | " << setw(14) << left << (record.getSubject().empty() ? "General" : record.getSubject())
@@ -1192,7 +5955,6 @@ private:
                 found = true;
             }
         }
-        file.close();
 
         if (!found) {
             setColor(COLOR_RED);
@@ -1203,13 +5965,13 @@ private:
 
         gotoxy(12, 19);
         cout << "Press any key to continue...";
-        _getch();
+        readKey();
     }
 
     void viewExamResults() {
         vector<ExamResult> results = ReportGenerator::loadStudentExamResults(rollNo);
         
-        system("cls");
+        clearScreen();
         drawBox(10, 2, 65, 15, "EXAM RESULTS - " + rollNo);
         
         if (results.empty()) {
@@ -1251,7 +6013,7 @@ private:
 
         gotoxy(12, 16);
         cout << "Press any key to continue...";
-        _getch();
+        readKey();
     }
 
     void generatePersonalReport() {
@@ -1269,7 +6031,7 @@ private:
             return;
         }
 
-        system("cls");
+        clearScreen();
         drawBox(20, 5, 40, 12, "STUDENT PROFILE");
         
         gotoxy(22, 7);
@@ -1291,7 +6053,7 @@ private:
 
         gotoxy(22, 14);
         cout << "Press any key to continue...";
-        _getch();
+        readKey();
     }
 
 public:
@@ -1313,8 +6075,7 @@ public:
     }
 
     bool saveCredentials() override {
-        // Credentials are saved during signup, no need to implement here
-        return true;
+        return StudentAccountStore::updatePassword(username, password);
     }
 
     void displayMenu() override {
@@ -1335,6 +6096,7 @@ public:
             choice = studentMenu.display();
             
             if (choice == -1) break;
+            PerfScope scope("Student: " + studentOptions[choice]);
 
             switch (choice) {
                 case 0: viewAttendanceSummary(); break;
@@ -1354,32 +6116,9 @@ public:
 // Admin Class (Updated with exam management)
 class Admin : public Person {
 private:
-    vector<Student> students;
     PasswordManager passwordManager;
     NotificationSystem notificationSystem;
 
-    void loadStudents() {
-        students.clear();
-        ifstream file(STUDENT_FILE);
-        if (!file) return;
-
-        Student student;
-        while (student.loadFromFile(file)) {
-            students.push_back(student);
-        }
-        file.close();
-    }
-
-    void saveStudents() {
-        ofstream file(STUDENT_FILE);
-        if (!file) return;
-
-        for (const auto& student : students) {
-            student.saveToFile(file);
-        }
-        file.close();
-    }
-
     bool adminLogin() {
         ifstream file(ADMIN_FILE);
         if (!file) {
@@ -1400,7 +6139,7 @@ private:
         username = storedUsername;
         password = storedPassword;
 
-        system("cls");
+        clearScreen();
         drawBox(20, 5, 40, 10, "ADMIN LOGIN");
         
         string inputUsername, inputPassword;
@@ -1413,7 +6152,7 @@ private:
         cout << "Password: ";
         string hiddenPass = "";
         char ch;
-        while ((ch = _getch()) != 13) {
+        while ((ch = readKey()) != 13) {
             if (ch == 8) {
                 if (!hiddenPass.empty()) {
                     hiddenPass.pop_back();
@@ -1454,7 +6193,7 @@ private:
     }
 
     void generateComprehensiveReport() {
-        loadStudents();
+        vector<Student> students = StudentRepository::all();
         if (students.empty()) {
             displayMessageBox("No students found to generate report!", true);
             return;
@@ -1468,13 +6207,13 @@ private:
     }
 
     void generateDepartmentWiseReport() {
-        loadStudents();
+        vector<Student> students = StudentRepository::all();
         if (students.empty()) {
             displayMessageBox("No students found to generate report!", true);
             return;
         }
 
-        if (ReportGenerator::generateDepartmentReportCSV(students)) {
+        if (ReportGenerator::generateDepartmentReportCSV()) {
             displayMessageBox("Department-wise report generated successfully as CSV file!", false);
         } else {
             displayMessageBox("Error generating department report!", true);
@@ -1488,7 +6227,7 @@ private:
             return;
         }
 
-        system("cls");
+        clearScreen();
         drawBox(15, 3, 50, 8, "GENERATE DAILY REPORT");
         
         gotoxy(17, 5);
@@ -1503,6 +6242,11 @@ private:
         string date;
         cin >> date;
 
+        if (date != "all" && !AttendanceStore::hasRecordsIn(dateToDays(date), dateToDays(date))) {
+            displayMessageBox("No attendance recorded on " + date + "!", true);
+            return;
+        }
+
         if (ReportGenerator::generateDailyAttendanceReportCSV(date)) {
             displayMessageBox("Daily report generated successfully as CSV file!", false);
         } else {
@@ -1510,8 +6254,76 @@ private:
         }
     }
 
+    void generateReportBundle() {
+        vector<Student> students = StudentRepository::all();
+        if (students.empty()) {
+            displayMessageBox("No students found to generate report!", true);
+            return;
+        }
+
+        vector<string> files;
+        if (ReportGenerator::generateReportBundle(students, files)) {
+            displayMessageBox("Comprehensive, department and daily reports generated!", false);
+        } else {
+            displayMessageBox("Error generating report bundle!", true);
+        }
+    }
+
+    void exportAttendanceText() {
+        string filename = "attendance_export_" + getCurrentDateTime() + ".txt";
+        if (AttendanceStore::exportText(filename)) {
+            displayMessageBox("Attendance exported to " + filename, false);
+        } else {
+            displayMessageBox("Error exporting attendance!", true);
+        }
+    }
+
+    void bulkImport() {
+        clearScreen();
+        drawBox(15, 3, 50, 12, "BULK IMPORT (CSV)");
+
+        gotoxy(17, 5);
+        cout << "1. Students (roll,name,dept,sem,email,phone)";
+        gotoxy(17, 6);
+        cout << "2. Attendance (roll,date,P/A,subject)";
+        gotoxy(17, 7);
+        cout << "3. Exam Results (roll,sem,subject,marks,type)";
+
+        gotoxy(17, 9);
+        cout << "Select type: ";
+        char type = readKey();
+        cout << type;
+        if (type < '1' || type > '3') {
+            displayMessageBox("Invalid choice!", true);
+            return;
+        }
+
+        string filename;
+        gotoxy(17, 10);
+        cout << "CSV file: ";
+        cin >> filename;
+
+        ImportSummary summary = type == '1' ? BulkImporter::importStudents(filename)
+                              : type == '2' ? BulkImporter::importAttendance(filename)
+                              : BulkImporter::importExamResults(filename);
+
+        if (!summary.opened) {
+            displayMessageBox("Cannot open " + filename + "!", true);
+            return;
+        }
+        if (!summary.committed) {
+            displayMessageBox("Error saving imported records!", true);
+            return;
+        }
+
+        string message = "Imported " + to_string(summary.accepted) + " rows, " +
+                         to_string(summary.rejected) + " rejected";
+        if (!summary.errorReport.empty()) message += " (see " + summary.errorReport + ")";
+        displayMessageBox(message, summary.rejected > 0);
+    }
+
     void addExamResult() {
-        system("cls");
+        clearScreen();
         drawBox(15, 3, 50, 12, "ADD EXAM RESULT");
         
         string rollNo, semester, subject, examType;
@@ -1522,15 +6334,7 @@ private:
         cin >> rollNo;
         
         // Verify student exists
-        bool studentExists = false;
-        for (const auto& student : students) {
-            if (student.getRollNo() == rollNo) {
-                studentExists = true;
-                break;
-            }
-        }
-        
-        if (!studentExists) {
+        if (!StudentRepository::exists(rollNo)) {
             displayMessageBox("Student not found!", true);
             return;
         }
@@ -1570,16 +6374,16 @@ private:
     }
 
     void viewExamResults() {
-        system("cls");
+        clearScreen();
         drawBox(10, 2, 70, 20, "ALL EXAM RESULTS");
         
-        ifstream file(EXAM_RESULTS_FILE);
-        if (!file) {
+        MappedFile file(EXAM_RESULTS_FILE);
+        if (!file.isOpen()) {
             gotoxy(12, 4);
             cout << "No exam results found!";
             gotoxy(12, 6);
             cout << "Press any key to continue...";
-            _getch();
+            readKey();
             return;
         }
         
@@ -1590,9 +6394,12 @@ private:
         cout << "-------  --------  --------------  -----------  -----  -----";
         setColor(COLOR_DEFAULT);
         
+        RecordReader reader(file);
+        vector<string_view> fields;
         ExamResult result;
         int line = 6;
-        while (result.loadFromFile(file) && line < 18) {
+        while (line < 18 && reader.next(fields)) {
+            result.loadFromFields(fields);
             gotoxy(12, line++);
             cout << setw(7) << left << result.getRollNo()
                  << "  " << setw(8) << left << result.getSemester()
@@ -1601,17 +6408,14 @@ private:
                  << "  " << setw(5) << right << fixed << setprecision(1) << result.getMarks()
                  << "  " << setw(5) << left << result.getGrade();
         }
-        file.close();
         
         gotoxy(12, 19);
         cout << "Press any key to continue...";
-        _getch();
+        readKey();
     }
 
 public:
-    Admin() : Person() {
-        loadStudents();
-    }
+    Admin() : Person() {}
 
     bool login() override {
         return adminLogin();
@@ -1634,13 +6438,18 @@ public:
             "Update Student",
             "Delete Student",
             "Search Student",
+            "Filter Students",
             "View Attendance Report",
             "Add Exam Result",
             "View Exam Results",
+            "Bulk Import (CSV)",
             "Generate Comprehensive Report",
             "Generate Department Report",
             "Generate Daily Report",
+            "Generate Report Bundle",
+            "Export Attendance (Text)",
             "System Statistics",
+            "Performance Stats",
             "Change Password",
             "View Notifications",
             "Logout"
@@ -1653,6 +6462,7 @@ public:
             choice = adminMenu.display();
             
             if (choice == -1) break;
+            PerfScope scope("Admin: " + adminOptions[choice]);
 
             switch (choice) {
                 case 0: addStudent(); break;
@@ -1660,22 +6470,27 @@ public:
                 case 2: updateStudent(); break;
                 case 3: deleteStudent(); break;
                 case 4: searchStudent(); break;
-                case 5: viewAttendanceReport(); break;
-                case 6: addExamResult(); break;
-                case 7: viewExamResults(); break;
-                case 8: generateComprehensiveReport(); break;
-                case 9: generateDepartmentWiseReport(); break;
-                case 10: generateDailyReport(); break;
-                case 11: showStatistics(); break;
-                case 12: passwordManager.changePassword(this, "admin"); break;
-                case 13: notificationSystem.showNotifications(); break;
-                case 14: return;
+                case 5: filterStudents(); break;
+                case 6: viewAttendanceReport(); break;
+                case 7: addExamResult(); break;
+                case 8: viewExamResults(); break;
+                case 9: bulkImport(); break;
+                case 10: generateComprehensiveReport(); break;
+                case 11: generateDepartmentWiseReport(); break;
+                case 12: generateDailyReport(); break;
+                case 13: generateReportBundle(); break;
+                case 14: exportAttendanceText(); break;
+                case 15: showStatistics(); break;
+                case 16: showPerformanceStats(); break;
+                case 17: passwordManager.changePassword(this, "admin"); break;
+                case 18: notificationSystem.showNotifications(); break;
+                case 19: return;
             }
         } while (true);
     }
 
     void addStudent() {
-        system("cls");
+        clearScreen();
         drawBox(15, 3, 50, 14, "ADD NEW STUDENT");
         
         string rollNo, name, department, email, phone;
@@ -1685,11 +6500,9 @@ public:
         cout << "Roll No: ";
         cin >> rollNo;
 
-        for (const auto& student : students) {
-            if (student.getRollNo() == rollNo) {
-                displayMessageBox("Error: Roll number already exists!", true);
-                return;
-            }
+        if (StudentRepository::exists(rollNo)) {
+            displayMessageBox("Error: Roll number already exists!", true);
+            return;
         }
 
         cin.ignore();
@@ -1716,8 +6529,11 @@ public:
 
         if (validateRollNo(rollNo) && validateName(name)) {
             Student newStudent(rollNo, name, department, semester, email, phone);
-            students.push_back(newStudent);
-            saveStudents();
+            if (!StudentRepository::add(newStudent)) {
+                displayMessageBox("Error saving student!", true);
+                return;
+            }
+            DepartmentRollup::addStudent(newStudent);
             displayMessageBox("Student added successfully!", false);
         } else {
             displayMessageBox("Invalid roll number or name!", true);
@@ -1725,10 +6541,36 @@ public:
     }
 
     void viewAllStudents() {
-        loadStudents();
-        system("cls");
+        showStudentTable(StudentRepository::all(), "ALL STUDENTS");
+    }
+
+    void filterStudents() {
+        clearScreen();
+        drawBox(15, 3, 50, 8, "FILTER STUDENTS");
+
+        string department, semesterText;
+        cin.ignore();
+        gotoxy(17, 5);
+        cout << "Department (blank for any): ";
+        getline(cin, department);
+
+        gotoxy(17, 6);
+        cout << "Semester (blank for any): ";
+        getline(cin, semesterText);
+
+        int semester = parseNumber<int>(semesterText, 0);
+        if (department.empty() && semester == 0) {
+            displayMessageBox("Enter a department or a semester!", true);
+            return;
+        }
+
+        showStudentTable(StudentRepository::filter(department, semester), "FILTERED STUDENTS");
+    }
+
+    void showStudentTable(const vector<Student>& students, const string& title) {
+        clearScreen();
         int boxHeight = max(static_cast<int>(students.size()) + 9, 12);
-        drawBox(3, 2, 74, boxHeight, "ALL STUDENTS");
+        drawBox(3, 2, 74, boxHeight, title);
         
         if (students.empty()) {
             setColor(COLOR_RED);
@@ -1762,11 +6604,11 @@ public:
         gotoxy(5, boxHeight - 2);
         cout << "\n Press any key to continue...";
         setColor(COLOR_DEFAULT);
-        _getch();
+        readKey();
     }
 
     void updateStudent() {
-        system("cls");
+        clearScreen();
         drawBox(15, 3, 50, 12, "UPDATE STUDENT");
         
         string rollNo;
@@ -1774,53 +6616,54 @@ public:
         cout << "Enter roll number to update: ";
         cin >> rollNo;
 
-        for (auto& student : students) {
-            if (student.getRollNo() == rollNo) {
-                string name, department, email, phone;
-                int semester;
+        Student student;
+        if (!StudentRepository::find(rollNo, student)) {
+            displayMessageBox("Student not found!", true);
+            return;
+        }
 
-                cin.ignore();
-                gotoxy(17, 7);
-                cout << "New Name: ";
-                getline(cin, name);
-                
-                gotoxy(17, 8);
-                cout << "New Department: ";
-                getline(cin, department);
-                
-                gotoxy(17, 9);
-                cout << "New Semester: ";
-                cin >> semester;
-                
-                cin.ignore();
-                gotoxy(17, 10);
-                cout << "New Email: ";
-                getline(cin, email);
-                
-                gotoxy(17, 11);
-                cout << "New Phone: ";
-                getline(cin, phone);
-
-                if (validateName(name)) {
-                    student.setName(name);
-                    student.setDepartment(department);
-                    student.setSemester(semester);
-                    student.setEmail(email);
-                    student.setPhone(phone);
-                    saveStudents();
-                    displayMessageBox("Student updated successfully!", false);
-                    return;
-                } else {
-                    displayMessageBox("Invalid name!", true);
-                    return;
-                }
-            }
+        string name, department, email, phone;
+        int semester;
+
+        cin.ignore();
+        gotoxy(17, 7);
+        cout << "New Name: ";
+        getline(cin, name);
+        
+        gotoxy(17, 8);
+        cout << "New Department: ";
+        getline(cin, department);
+        
+        gotoxy(17, 9);
+        cout << "New Semester: ";
+        cin >> semester;
+        
+        cin.ignore();
+        gotoxy(17, 10);
+        cout << "New Email: ";
+        getline(cin, email);
+        
+        gotoxy(17, 11);
+        cout << "New Phone: ";
+        getline(cin, phone);
+
+        if (!validateName(name)) {
+            displayMessageBox("Invalid name!", true);
+            return;
+        }
+
+        Student updated(student.getRollNo(), name, department, semester, email, phone);
+        if (!StudentRepository::update(updated)) {
+            displayMessageBox("Error saving student!", true);
+            return;
         }
-        displayMessageBox("Student not found!", true);
+        DepartmentRollup::removeStudent(student);
+        DepartmentRollup::addStudent(updated);
+        displayMessageBox("Student updated successfully!", false);
     }
 
     void deleteStudent() {
-        system("cls");
+        clearScreen();
         drawBox(15, 3, 50, 6, "DELETE STUDENT");
         
         string rollNo;
@@ -1828,12 +6671,13 @@ public:
         cout << "Enter roll number to delete: ";
         cin >> rollNo;
 
-        auto it = remove_if(students.begin(), students.end(),
-            [&rollNo](const Student& s) { return s.getRollNo() == rollNo; });
-
-        if (it != students.end()) {
-            students.erase(it, students.end());
-            saveStudents();
+        Student student;
+        if (StudentRepository::find(rollNo, student)) {
+            if (!StudentRepository::remove(rollNo)) {
+                displayMessageBox("Error saving student!", true);
+                return;
+            }
+            DepartmentRollup::removeStudent(student);
             displayMessageBox("Student deleted successfully!", false);
         } else {
             displayMessageBox("Student not found!", true);
@@ -1841,7 +6685,7 @@ public:
     }
 
     void searchStudent() {
-        system("cls");
+        clearScreen();
         drawBox(15, 3, 50, 8, "SEARCH STUDENT");
         
         string rollNo;
@@ -1849,48 +6693,43 @@ public:
         cout << "Enter roll number: ";
         cin >> rollNo;
 
-        bool found = false;
-        for (const auto& student : students) {
-            if (student.getRollNo() == rollNo) {
-                found = true;
-                system("cls");
-                drawBox(15, 3, 50, 12, "STUDENT FOUND");
-                gotoxy(17, 5);
-                cout << "Roll No: " << student.getRollNo();
-                gotoxy(17, 6);
-                cout << "Name: " << student.getName();
-                gotoxy(17, 7);
-                cout << "Department: " << student.getDepartment();
-                gotoxy(17, 8);
-                cout << "Semester: " << student.getSemester();
-                if (!student.getEmail().empty()) {
-                    gotoxy(17, 9);
-                    cout << "Email: " << student.getEmail();
-                }
-                if (!student.getPhone().empty()) {
-                    gotoxy(17, 10);
-                    cout << "Phone: " << student.getPhone();
-                }
-                
-                double percentage = Attendance::calculateAttendancePercentage(rollNo);
-                gotoxy(17, 11);
-                cout << "Attendance: " << fixed << setprecision(2) << percentage << "%";
-                
-                gotoxy(17, 13);
-                cout << "Press any key to continue...";
-                _getch();
-                return;
-            }
-        }
-        
-        if (!found) {
+        Student student;
+        if (!StudentRepository::find(rollNo, student)) {
             displayMessageBox("Student not found!", true);
+            return;
+        }
+
+        clearScreen();
+        drawBox(15, 3, 50, 12, "STUDENT FOUND");
+        gotoxy(17, 5);
+        cout << "Roll No: " << student.getRollNo();
+        gotoxy(17, 6);
+        cout << "Name: " << student.getName();
+        gotoxy(17, 7);
+        cout << "Department: " << student.getDepartment();
+        gotoxy(17, 8);
+        cout << "Semester: " << student.getSemester();
+        if (!student.getEmail().empty()) {
+            gotoxy(17, 9);
+            cout << "Email: " << student.getEmail();
         }
+        if (!student.getPhone().empty()) {
+            gotoxy(17, 10);
+            cout << "Phone: " << student.getPhone();
+        }
+        
+        double percentage = Attendance::calculateAttendancePercentage(rollNo);
+        gotoxy(17, 11);
+        cout << "Attendance: " << fixed << setprecision(2) << percentage << "%";
+        
+        gotoxy(17, 13);
+        cout << "Press any key to continue...";
+        readKey();
     }
 
     void viewAttendanceReport() {
-        loadStudents();
-        system("cls");
+        vector<Student> students = StudentRepository::all();
+        clearScreen();
         int boxHeight = max(static_cast<int>(students.size()) + 9, 12);
         drawBox(3, 2, 74, boxHeight, "ATTENDANCE REPORT");
         
@@ -1901,8 +6740,10 @@ public:
         cout << "-------  ------------------  ----------";
         setColor(COLOR_DEFAULT);
 
+        vector<AttendanceCounter> totals = AttendanceIndex::totalsFor(students);
         for (int i = 0; i < students.size(); i++) {
-            double percentage = Attendance::calculateAttendancePercentage(students[i].getRollNo());
+            const AttendanceCounter& counter = totals[i];
+            double percentage = counter.total > 0 ? (static_cast<double>(counter.present) / counter.total) * 100 : 0.0;
             gotoxy(5, 6 + i);
             cout << setw(7) << left << students[i].getRollNo() 
                  << "  " << setw(18) << left << students[i].getName() << "  ";
@@ -1927,37 +6768,26 @@ public:
         gotoxy(5, boxHeight - 2);
         cout << "Press any key to continue...";
         setColor(COLOR_DEFAULT);
-        _getch();
+        readKey();
     }
 
     void showStatistics() {
-        loadStudents();
+        vector<Student> students = StudentRepository::all();
+        DepartmentRollup::ensure();
         
         int totalStudents = students.size();
         map<string, int> deptCount;
-        map<int, int> semCount;
+        map<int, int> semCount = DepartmentRollup::headcountBySemester();
         
-        for (const auto& student : students) {
-            deptCount[student.getDepartment()]++;
-            semCount[student.getSemester()]++;
-        }
-        
-        // Count student accounts
-        int studentAccounts = 0;
-        ifstream credFile(STUDENT_CREDENTIALS_FILE);
-        if (credFile) {
-            string line;
-            while (getline(credFile, line)) {
-                if (line.find('|') == string::npos) { // Simple line count for credentials
-                    studentAccounts++;
-                }
-            }
-            credFile.close();
+        for (const auto& dept : DepartmentRollup::byDepartment()) {
+            if (dept.second.headcount > 0) deptCount[dept.first] = dept.second.headcount;
         }
-        studentAccounts /= 4; // Each account has 4 lines
         
-        system("cls");
-        drawBox(10, 2, 60, 18, "SYSTEM STATISTICS");
+        int studentAccounts = StudentAccountStore::count();
+        AttendanceCounter attendance = AttendanceIndex::classTotals();
+        
+        clearScreen();
+        drawBox(10, 2, 60, max(21, 19 + static_cast<int>(deptCount.size() + semCount.size())), "SYSTEM STATISTICS");
         
         gotoxy(12, 4);
         cout << "Total Students in Database: " << totalStudents;
@@ -1980,9 +6810,84 @@ public:
             cout << "Semester " << sem.first << ": " << sem.second << " students";
         }
         
+        gotoxy(12, line + 1);
+        cout << "Attendance Records:";
+        line += 2;
+        gotoxy(15, line++);
+        cout << attendance.present << " present of " << attendance.total;
+        if (attendance.total > 0) {
+            cout << " (" << fixed << setprecision(2) << (static_cast<double>(attendance.present) / attendance.total) * 100 << "%)";
+        }
+        
+        Screen::FrameStats display = Screen::frameStats();
+        gotoxy(12, line + 1);
+        cout << "Display Output:";
+        line += 2;
+        gotoxy(15, line++);
+        cout << "Frames drawn: " << display.frames;
+        if (display.frames > 0) {
+            gotoxy(15, line++);
+            cout << "Average per frame: " << display.bytes / display.frames << " bytes, "
+                 << fixed << setprecision(2) << double(display.writes) / display.frames << " writes";
+            gotoxy(15, line++);
+            cout << "Last frame: " << display.lastBytes << " bytes, " << display.lastWrites << " writes, "
+                 << display.lastCells << " cells changed";
+        }
+
         gotoxy(12, line + 1);
         cout << "Press any key to continue...";
-        _getch();
+        readKey();
+    }
+
+    // Operations timed so far this session, the most expensive first. Time waiting at
+    // prompts is left out of the ms column.
+    void showPerformanceStats() {
+        const int shown = 18;
+        int key;
+        do {
+            vector<pair<string, PerfStats::Entry>> operations = PerfStats::snapshot();
+            int rows = min(static_cast<int>(operations.size()), shown);
+            
+            clearScreen();
+            drawBox(2, 1, 76, max(10, rows + 8), "PERFORMANCE STATS");
+            
+            gotoxy(4, 3);
+            cout << left << setw(21) << "Operation" << right << setw(6) << "Calls" << setw(9) << "ms"
+                 << setw(7) << "Files" << setw(7) << "KB" << setw(8) << "Parsed" << setw(8) << "Matched"
+                 << setw(8) << "Allocs" << left;
+            
+            for (int i = 0; i < rows; i++) {
+                const PerfStats::Entry& entry = operations[i].second;
+                const uint64_t* values = entry.counters.values;
+                gotoxy(4, 4 + i);
+                cout << left << setw(21) << operations[i].first.substr(0, 20) << right
+                     << setw(6) << entry.calls
+                     << setw(9) << fixed << setprecision(1) << entry.totalMs
+                     << setw(7) << values[PerfCounters::FILES_OPENED]
+                     << setw(7) << values[PerfCounters::BYTES_READ] / 1024
+                     << setw(8) << values[PerfCounters::RECORDS_PARSED]
+                     << setw(8) << values[PerfCounters::RECORDS_MATCHED]
+                     << setw(8) << values[PerfCounters::ALLOCATIONS] << left;
+            }
+            if (operations.empty()) {
+                gotoxy(4, 4);
+                cout << "Nothing timed yet.";
+            }
+            
+            gotoxy(4, max(10, rows + 8) - 1);
+            setColor(COLOR_YELLOW);
+            cout << "D: Dump to CSV   R: Reset   Any other key: Back";
+            setColor(COLOR_DEFAULT);
+            
+            key = toupper(readKey());
+            if (key == 'D') {
+                string filename = "perf_stats_" + getCurrentDateTime() + ".csv";
+                if (PerfStats::dump(filename)) displayMessageBox("Performance stats saved to " + filename, false);
+                else displayMessageBox("Error writing performance stats!", true);
+            } else if (key == 'R') {
+                PerfStats::reset();
+            }
+        } while (key == 'D' || key == 'R');
     }
 };
 
@@ -2011,7 +6916,7 @@ private:
         username = storedUsername;
         password = storedPassword;
 
-        system("cls");
+        clearScreen();
         drawBox(20, 5, 40, 10, "TEACHER LOGIN");
         
         string inputUsername, inputPassword;
@@ -2024,7 +6929,7 @@ private:
         cout << "Password: ";
         string hiddenPass = "";
         char ch;
-        while ((ch = _getch()) != 13) {
+        while ((ch = readKey()) != 13) {
             if (ch == 8) {
                 if (!hiddenPass.empty()) {
                     hiddenPass.pop_back();
@@ -2065,16 +6970,7 @@ private:
     }
 
     vector<Student> loadAllStudents() {
-        vector<Student> allStudents;
-        ifstream file(STUDENT_FILE);
-        if (!file) return allStudents;
-
-        Student student;
-        while (student.loadFromFile(file)) {
-            allStudents.push_back(student);
-        }
-        file.close();
-        return allStudents;
+        return StudentRepository::all();
     }
 
     void generateClassReport() {
@@ -2092,13 +6988,12 @@ private:
     }
 
     void generateStudentMonthlyReport() {
-        vector<Student> students = loadAllStudents();
-        if (students.empty()) {
+        if (StudentRepository::count() == 0) {
             displayMessageBox("No students found!", true);
             return;
         }
 
-        system("cls");
+        clearScreen();
         drawBox(15, 3, 50, 8, "STUDENT MONTHLY REPORT");
         
         string rollNo;
@@ -2106,15 +7001,7 @@ private:
         cout << "Enter student roll number: ";
         cin >> rollNo;
 
-        bool studentExists = false;
-        for (const auto& student : students) {
-            if (student.getRollNo() == rollNo) {
-                studentExists = true;
-                break;
-            }
-        }
-
-        if (!studentExists) {
+        if (!StudentRepository::exists(rollNo)) {
             displayMessageBox("Student not found!", true);
             return;
         }
@@ -2131,6 +7018,33 @@ private:
         }
     }
 
+    void generateAllMonthlyReports() {
+        vector<Student> students = loadAllStudents();
+        if (students.empty()) {
+            displayMessageBox("No students found!", true);
+            return;
+        }
+
+        clearScreen();
+        drawBox(15, 3, 50, 6, "MONTHLY REPORTS (ALL STUDENTS)");
+
+        gotoxy(17, 5);
+        cout << "Enter month and year (YYYY-MM): ";
+        string monthYear;
+        cin >> monthYear;
+
+        vector<string> rollNos;
+        rollNos.reserve(students.size());
+        for (const auto& student : students) rollNos.push_back(student.getRollNo());
+
+        string directory;
+        if (ReportGenerator::generateMonthlyReportsCSV(rollNos, monthYear, directory)) {
+            displayMessageBox(to_string(rollNos.size()) + " monthly reports written to " + directory, false);
+        } else {
+            displayMessageBox("Error generating monthly reports!", true);
+        }
+    }
+
     void generateDailyAttendanceReport() {
         vector<string> dates = Attendance::getAvailableDates();
         if (dates.empty()) {
@@ -2138,7 +7052,7 @@ private:
             return;
         }
 
-        system("cls");
+        clearScreen();
         drawBox(15, 3, 50, 8, "GENERATE DAILY REPORT");
         
         gotoxy(17, 5);
@@ -2153,6 +7067,11 @@ private:
         string date;
         cin >> date;
 
+        if (date != "all" && !AttendanceStore::hasRecordsIn(dateToDays(date), dateToDays(date))) {
+            displayMessageBox("No attendance recorded on " + date + "!", true);
+            return;
+        }
+
         if (ReportGenerator::generateDailyAttendanceReportCSV(date)) {
             displayMessageBox("Daily report generated successfully as CSV file!", false);
         } else {
@@ -2160,6 +7079,112 @@ private:
         }
     }
 
+    // Students absent on a day, or on every one of several days (e.g. Monday and Tuesday),
+    // answered from the attendance index's day rosters
+    void viewDailyAbsentees() {
+        vector<string> dates = Attendance::getAvailableDates();
+        if (dates.empty()) {
+            displayMessageBox("No attendance records found!", true);
+            return;
+        }
+
+        clearScreen();
+        drawBox(8, 3, 64, 9, "DAILY ABSENTEE LIST");
+
+        string dateText, subject;
+        cin.ignore();
+        gotoxy(10, 5);
+        cout << "Latest class day: " << dates.back();
+        gotoxy(10, 6);
+        cout << "Date(s), comma-separated (blank for latest): ";
+        getline(cin, dateText);
+        gotoxy(10, 7);
+        cout << "Subject (blank for any): ";
+        getline(cin, subject);
+
+        vector<int> days;
+        string dateList;
+        stringstream dateStream(dateText.empty() ? dates.back() : dateText);
+        string date;
+        while (getline(dateStream, date, ',')) {
+            date.erase(0, date.find_first_not_of(' '));
+            date.erase(date.find_last_not_of(' ') + 1);
+            if (date.empty()) continue;
+            if (!AttendanceStore::hasRecordsIn(dateToDays(date), dateToDays(date))) {
+                displayMessageBox("No attendance recorded on " + date + "!", true);
+                return;
+            }
+            days.push_back(dateToDays(date));
+            dateList += (dateList.empty() ? "" : ", ") + date;
+        }
+        if (days.empty()) {
+            displayMessageBox("Enter at least one date!", true);
+            return;
+        }
+
+        vector<string> absent = AttendanceIndex::absentOnAll(days, subject);
+        AttendanceCounter marked;
+        if (days.size() == 1) marked = AttendanceIndex::dayCounts(days[0], subject);
+
+        // The box is capped at 25 lines like the marking screens; longer lists are paged
+        const size_t pageRows = 14;
+        size_t pages = max<size_t>(1, (absent.size() + pageRows - 1) / pageRows);
+        for (size_t page = 0; page < pages; page++) {
+            size_t first = page * pageRows;
+            size_t shown = min(pageRows, absent.size() - first);
+
+            clearScreen();
+            int boxHeight = max(static_cast<int>(shown) + 11, 12);
+            drawBox(3, 2, 74, boxHeight, "ABSENTEES");
+
+            setColor(COLOR_CYAN);
+            gotoxy(5, 4);
+            cout << "Date(s): " << dateList << "   Subject: " << (subject.empty() ? "Any" : subject);
+            gotoxy(5, 5);
+            if (days.size() == 1) {
+                cout << "Marked: " << marked.total << "   Present: " << marked.present << "   Absent: " << absent.size();
+            } else {
+                cout << "Absent on all " << days.size() << " days: " << absent.size();
+            }
+            setColor(COLOR_DEFAULT);
+
+            if (absent.empty()) {
+                setColor(COLOR_GREEN);
+                gotoxy(5, 7);
+                cout << "No absentees!";
+                setColor(COLOR_DEFAULT);
+            } else {
+                gotoxy(5, 7);
+                setColor(COLOR_YELLOW);
+                cout << "Roll No  Name                Department    Semester";
+                gotoxy(5, 8);
+                cout << "-------  ------------------  ------------  --------";
+                setColor(COLOR_DEFAULT);
+
+                for (size_t i = 0; i < shown; i++) {
+                    const string& rollNo = absent[first + i];
+                    Student student;
+                    bool known = StudentRepository::find(rollNo, student);
+                    gotoxy(5, 9 + static_cast<int>(i));
+                    cout << setw(7) << left << rollNo
+                         << "  " << setw(18) << left << (known ? student.getName() : "Unknown")
+                         << "  " << setw(12) << left << (known ? student.getDepartment() : "")
+                         << "  " << setw(8) << left << (known ? to_string(student.getSemester()) : "");
+                }
+            }
+
+            setColor(COLOR_YELLOW);
+            gotoxy(5, boxHeight - 2);
+            if (page + 1 < pages) {
+                cout << "\n Page " << (page + 1) << " of " << pages << " - any key for the next page, Esc to stop...";
+            } else {
+                cout << "\n Press any key to continue...";
+            }
+            setColor(COLOR_DEFAULT);
+            if (readKey() == 27) break;
+        }
+    }
+
 public:
     User() : Person() {}
 
@@ -2186,7 +7211,9 @@ public:
             "Check Attendance Percentage",
             "Generate Class Report",
             "Generate Student Monthly Report",
+            "Monthly Reports (All Students)",
             "Generate Daily Report",
+            "Daily Absentee List",
             "Change Password",
             "Logout"
         };
@@ -2198,6 +7225,7 @@ public:
             choice = teacherMenu.display();
             
             if (choice == -1) break;
+            PerfScope scope("Teacher: " + teacherOptions[choice]);
 
             switch (choice) {
                 case 0: markAttendance(); break;
@@ -2207,9 +7235,11 @@ public:
                 case 4: checkAttendancePercentage(); break;
                 case 5: generateClassReport(); break;
                 case 6: generateStudentMonthlyReport(); break;
-                case 7: generateDailyAttendanceReport(); break;
-                case 8: passwordManager.changePassword(this, "teacher"); break;
-                case 9: return;
+                case 7: generateAllMonthlyReports(); break;
+                case 8: generateDailyAttendanceReport(); break;
+                case 9: viewDailyAbsentees(); break;
+                case 10: passwordManager.changePassword(this, "teacher"); break;
+                case 11: return;
             }
         } while (true);
     }
@@ -2222,17 +7252,13 @@ public:
         }
 
         string date = getCurrentDate();
-        system("cls");
+        clearScreen();
         int boxHeight = students.size() + 7;
         if (boxHeight > 25) boxHeight = 25;
         
         drawBox(10, 2, 65, boxHeight, "MARK ATTENDANCE - " + date);
 
-        ofstream file(ATTENDANCE_FILE, ios::app);
-        if (!file) {
-            displayMessageBox("Error opening attendance file!", true);
-            return;
-        }
+        AttendanceBatch batch;
 
         for (int i = 0; i < students.size() && i < boxHeight - 7; i++) {
             char status;
@@ -2246,10 +7272,13 @@ public:
             cin >> status;
 
             string attendanceStatus = (toupper(status) == 'P') ? "P" : "A";
-            Attendance record(students[i].getRollNo(), date, attendanceStatus);
-            record.saveToFile(file);
+            batch.add(students[i].getRollNo(), date, attendanceStatus);
+        }
+
+        if (!batch.commit()) {
+            displayMessageBox("Error saving attendance!", true);
+            return;
         }
-        file.close();
         
         displayMessageBox("Attendance marked successfully!", false);
     }
@@ -2264,7 +7293,7 @@ public:
         string date = getCurrentDate();
         string subject;
         
-        system("cls");
+        clearScreen();
         drawBox(15, 3, 50, 8, "SUBJECT-WISE ATTENDANCE");
         
         gotoxy(17, 5);
@@ -2272,17 +7301,13 @@ public:
         cin.ignore();
         getline(cin, subject);
         
-        system("cls");
+        clearScreen();
         int boxHeight = students.size() + 7;
         if (boxHeight > 25) boxHeight = 25;
         
         drawBox(10, 2, 65, boxHeight, "MARK ATTENDANCE - " + subject + " - " + date);
 
-        ofstream file(ATTENDANCE_FILE, ios::app);
-        if (!file) {
-            displayMessageBox("Error opening attendance file!", true);
-            return;
-        }
+        AttendanceBatch batch;
 
         for (int i = 0; i < students.size() && i < boxHeight - 7; i++) {
             char status;
@@ -2296,10 +7321,13 @@ public:
             cin >> status;
 
             string attendanceStatus = (toupper(status) == 'P') ? "P" : "A";
-            Attendance record(students[i].getRollNo(), date, attendanceStatus, subject);
-            record.saveToFile(file);
+            batch.add(students[i].getRollNo(), date, attendanceStatus, subject);
+        }
+
+        if (!batch.commit()) {
+            displayMessageBox("Error saving attendance!", true);
+            return;
         }
-        file.close();
         
         displayMessageBox("Subject attendance marked successfully!", false);
     }
@@ -2313,7 +7341,7 @@ public:
 
         string date = getCurrentDate();
         
-        system("cls");
+        clearScreen();
         drawBox(10, 2, 50, 8, "QUICK ATTENDANCE - " + date);
         
         gotoxy(12, 4);
@@ -2331,17 +7359,16 @@ public:
             return;
         }
         
-        ofstream file(ATTENDANCE_FILE, ios::app);
-        if (!file) {
-            displayMessageBox("Error opening attendance file!", true);
-            return;
-        }
+        AttendanceBatch batch;
         
         for (const auto& student : students) {
-            Attendance record(student.getRollNo(), date, status);
-            record.saveToFile(file);
+            batch.add(student.getRollNo(), date, status);
+        }
+
+        if (!batch.commit()) {
+            displayMessageBox("Error saving attendance!", true);
+            return;
         }
-        file.close();
         
         string message = "Attendance marked for " + to_string(students.size()) + 
                         " students as " + (status == "P" ? "Present" : "Absent");
@@ -2349,7 +7376,7 @@ public:
     }
 
     void viewIndividualAttendance() {
-        system("cls");
+        clearScreen();
         drawBox(15, 3, 50, 8, "VIEW INDIVIDUAL ATTENDANCE");
         
         string rollNo;
@@ -2357,13 +7384,13 @@ public:
         cout << "Enter student roll number: ";
         cin >> rollNo;
 
-        ifstream file(ATTENDANCE_FILE);
-        if (!file) {
+        const AttendanceColumns& columns = AttendanceStore::getColumns();
+        if (columns.size() == 0) {
             displayMessageBox("No attendance records found!", true);
             return;
         }
 
-        system("cls");
+        clearScreen();
         drawBox(10, 2, 65, 20, "ATTENDANCE RECORD - " + rollNo);
         
         gotoxy(12, 4);
@@ -2373,12 +7400,13 @@ public:
         cout << "--------------|----------------|---------";
         setColor(COLOR_DEFAULT);
 
-        Attendance record;
+        auto rollId = columns.rollIds.find(rollNo);
         bool found = false;
         int line = 6;
 
-        while (record.loadFromFile(file) && line < 18) {
-            if (record.getRollNo() == rollNo) {
+        for (size_t i = 0; rollId != columns.rollIds.end() && i < columns.size() && line < 18; i++) {
+            if (columns.rolls[i] == rollId->second) {
+                Attendance record = columns.record(i);
                 gotoxy(12, line++);
                 cout << setw(12) << left << record.getDate() 
                      << " | " << setw(14) << left << (record.getSubject().empty() ? "General" : record.getSubject())
@@ -2386,7 +7414,6 @@ public:
                 found = true;
             }
         }
-        file.close();
 
         if (!found) {
             setColor(COLOR_RED);
@@ -2411,11 +7438,11 @@ public:
         
         gotoxy(12, 19);
         cout << "Press any key to continue...";
-        _getch();
+        readKey();
     }
 
     void checkAttendancePercentage() {
-        system("cls");
+        clearScreen();
         drawBox(15, 3, 50, 8, "CHECK ATTENDANCE PERCENTAGE");
         
         string rollNo;
@@ -2425,7 +7452,7 @@ public:
 
         double percentage = Attendance::calculateAttendancePercentage(rollNo);
         
-        system("cls");
+        clearScreen();
         drawBox(20, 8, 40, 7, "ATTENDANCE RESULT");
         gotoxy(22, 10);
         cout << "Roll Number: " << rollNo;
@@ -2443,7 +7470,789 @@ public:
         
         gotoxy(22, 14);
         cout << "Press any key to continue...";
-        _getch();
+        readKey();
+    }
+};
+
+// Benchmark Config - options of the bench command
+struct BenchmarkConfig {
+    size_t students = 10000;
+    int days = 20;                      // class days (weekdays)
+    int subjects = 4;
+    unsigned seed = 42;
+    string directory = "bench_data";    // generated data lives here, never in the real files
+    vector<size_t> scales;              // run once per student count, each in a fresh process
+    bool startupProbe = false;          // internal: time a single startup in the current directory
+};
+
+// Benchmark Class
+// Generates a synthetic data set - students spread over departments and semesters,
+// a roll call per subject on every class day, exam results and student accounts -
+// in a scratch directory and times the core paths on it. Absences are skewed: most
+// students are rarely away while a small group misses a large share of classes.
+// Every step records its wall time and the peak resident memory it reached; the
+// results come back as one JSON document so runs can be compared across releases.
+// Startup is timed in a child process of the same executable, cold (no warm start
+// file) and warm, because nothing in this process can be unloaded again.
+class Benchmark {
+private:
+    struct Step {
+        string name;
+        double ms;
+        size_t ops;
+        long peakKb;
+        bool ok;
+        size_t bytes;       // input scanned, for throughput steps
+    };
+
+    static constexpr const char* DATA_MARKER = ".benchmark_data";
+
+    vector<Step> steps;
+    size_t attendanceRecords = 0;
+    size_t examResults = 0;
+    size_t accounts = 0;
+    vector<string> subjectNames;
+    int firstDay = 0;
+
+    // Peak resident memory since the last resetPeakMemory(), in KB (-1 if unknown)
+    static long peakMemoryKb() {
+#ifdef _WIN32
+        PROCESS_MEMORY_COUNTERS counters;
+        if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) {
+            return static_cast<long>(counters.PeakWorkingSetSize / 1024);
+        }
+#else
+        ifstream status("/proc/self/status");
+        string line;
+        while (getline(status, line)) {
+            if (line.compare(0, 6, "VmHWM:") == 0) return atol(line.c_str() + 6);
+        }
+        rusage usage;
+        if (getrusage(RUSAGE_SELF, &usage) == 0) return usage.ru_maxrss;
+#endif
+        return -1;
+    }
+
+    // Linux can reset the high-water mark, so each step reports its own peak;
+    // elsewhere the figure is the peak of the whole run so far
+    static void resetPeakMemory() {
+#ifndef _WIN32
+        ofstream clear("/proc/self/clear_refs");
+        if (clear) clear << "5";
+#endif
+    }
+
+    template <typename Operation>
+    void measure(const string& name, size_t ops, Operation operation, size_t bytes = 0) {
+        resetPeakMemory();
+        auto start = chrono::steady_clock::now();
+        bool ok = operation();
+        double ms = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+        steps.push_back({name, ms, ops, peakMemoryKb(), ok, bytes});
+    }
+
+    static string programPath(const string& argv0) {
+#ifdef _WIN32
+        char buffer[MAX_PATH];
+        DWORD length = GetModuleFileNameA(NULL, buffer, MAX_PATH);
+        if (length > 0 && length < MAX_PATH) return string(buffer, length);
+#else
+        error_code ec;
+        filesystem::path self = filesystem::read_symlink("/proc/self/exe", ec);
+        if (!ec) return self.string();
+#endif
+        return filesystem::absolute(argv0).string();
+    }
+
+    // Runs this program with the given arguments and collects its standard output
+    static bool runChild(const string& program, const string& arguments, string& output) {
+        string command = "\"" + program + "\" " + arguments;
+#ifdef _WIN32
+        FILE* pipe = _popen(("\"" + command + "\"").c_str(), "r");
+#else
+        FILE* pipe = popen(command.c_str(), "r");
+#endif
+        if (!pipe) return false;
+
+        char buffer[4096];
+        size_t n;
+        while ((n = fread(buffer, 1, sizeof(buffer), pipe)) > 0) output.append(buffer, n);
+#ifdef _WIN32
+        return _pclose(pipe) == 0;
+#else
+        return pclose(pipe) == 0;
+#endif
+    }
+
+    // Empties the data directory, refusing one that holds anything but earlier bench data
+    static bool prepareDirectory(const string& directory) {
+        error_code ec;
+        filesystem::path path(directory);
+        if (filesystem::exists(path, ec)) {
+            if (!filesystem::is_empty(path, ec) && !filesystem::exists(path / DATA_MARKER, ec)) return false;
+            filesystem::remove_all(path, ec);
+        }
+        filesystem::create_directories(path, ec);
+        if (ec) return false;
+        ofstream marker((path / DATA_MARKER).string());
+        return static_cast<bool>(marker);
+    }
+
+    static string jsonString(const string& value) {
+        string quoted = "\"";
+        for (char c : value) {
+            if (c == '"' || c == '\\') quoted += '\\';
+            quoted += c;
+        }
+        return quoted + "\"";
+    }
+
+    static void removeReport(const string& filename) {
+        error_code ec;
+        filesystem::remove(filename, ec);
+    }
+
+    // Writes students.txt, attendance.txt, exam_results.txt and the legacy credentials
+    // file in their text formats, the way a long-running installation would have them
+    bool generate(const BenchmarkConfig& config, vector<Student>& students) {
+        mt19937 rng(config.seed);
+        uniform_real_distribution<double> unit(0.0, 1.0);
+
+        const vector<string> departments = {"CS", "IT", "ME", "EE", "CE", "EC"};
+        const vector<double> departmentShare = {0.30, 0.22, 0.15, 0.13, 0.10, 0.10};
+        const vector<string> firstNames = {"Aarav", "Diya", "Kabir", "Meera", "Rohan", "Isha", "Arjun", "Nisha",
+                                           "Vivaan", "Priya", "Dev", "Tara", "Kiran", "Leela", "Yash", "Zoya"};
+        const vector<string> lastNames = {"Shah", "Patel", "Mehta", "Rao", "Iyer", "Desai", "Joshi", "Nair",
+                                          "Gupta", "Kapoor", "Singh", "Verma", "Bose", "Reddy", "Das", "Malhotra"};
+        const vector<string> subjectPool = {"Mathematics", "Physics", "Chemistry", "Programming", "Electronics",
+                                            "Mechanics", "Statistics", "Databases", "Networks", "Economics"};
+        discrete_distribution<int> pickDepartment(departmentShare.begin(), departmentShare.end());
+
+        subjectNames.clear();
+        for (int s = 0; s < config.subjects; s++) {
+            subjectNames.push_back(s < static_cast<int>(subjectPool.size()) ? subjectPool[s]
+                                                                             : "Elective " + to_string(s + 1));
+        }
+
+        // Absence probability per student: u^4 keeps most students near the floor
+        vector<double> absenceRate(config.students);
+        students.clear();
+        students.reserve(config.students);
+        for (size_t i = 0; i < config.students; i++) {
+            string rollNo = to_string(100000 + i);
+            string name = firstNames[rng() % firstNames.size()] + " " + lastNames[rng() % lastNames.size()];
+            students.emplace_back(rollNo, name, departments[pickDepartment(rng)], 1 + static_cast<int>(rng() % 8),
+                                  "s" + rollNo + "@college.edu", to_string(9000000000ULL + rng() % 1000000000ULL));
+            double u = unit(rng);
+            absenceRate[i] = 0.02 + 0.45 * u * u * u * u;
+        }
+        vector<double> subjectFactor(config.subjects);
+        for (auto& factor : subjectFactor) factor = 0.7 + 0.6 * unit(rng);
+
+        // Class days are consecutive weekdays from the first Monday of 2026
+        firstDay = dateToDays("2026-01-05");
+        vector<string> dates;
+        for (int day = firstDay; static_cast<int>(dates.size()) < config.days; day++) {
+            int weekday = ((day % 7) + 11) % 7;     // 0 = Monday
+            if (weekday < 5) dates.push_back(daysToDate(day));
+        }
+
+        string text;
+        text.reserve(config.students * config.days * config.subjects * 32);
+        for (const auto& date : dates) {
+            for (int s = 0; s < config.subjects; s++) {
+                for (size_t i = 0; i < config.students; i++) {
+                    bool absent = unit(rng) < absenceRate[i] * subjectFactor[s];
+                    text += students[i].getRollNo();
+                    text += '|';
+                    text += date;
+                    text += absent ? "|A|" : "|P|";
+                    text += subjectNames[s];
+                    text += '\n';
+                }
+            }
+        }
+        attendanceRecords = config.students * dates.size() * config.subjects;
+        if (!writeFileAtomically(ATTENDANCE_FILE, text)) return false;
+
+        normal_distribution<double> marks(65.0, 15.0);
+        ostringstream exams;
+        for (const auto& student : students) {
+            for (int s = 0; s < config.subjects; s++) {
+                double score = min(100.0, max(0.0, round(marks(rng))));
+                ExamResult(student.getRollNo(), to_string(student.getSemester()), subjectNames[s], score,
+                           ExamResult::calculateGrade(score), "Midterm").saveToFile(exams);
+            }
+        }
+        examResults = students.size() * config.subjects;
+        if (!writeFileAtomically(EXAM_RESULTS_FILE, exams.str())) return false;
+
+        // Every other student has a portal account; the store converts this file on first use
+        ostringstream credentials;
+        accounts = 0;
+        for (size_t i = 0; i < students.size(); i += 2) {
+            credentials << "user" << students[i].getRollNo() << "\n" << encryptDecrypt("pw" + students[i].getRollNo())
+                        << "\n" << students[i].getRollNo() << "\n" << students[i].getName() << "\n";
+            accounts++;
+        }
+        return writeFileAtomically(STUDENT_CREDENTIALS_FILE, credentials.str());
+    }
+
+    // Counts fields the way the loaders see them, through a mapping or through getline
+    static size_t countFieldsMapped(const string& filename) {
+        MappedFile file(filename);
+        RecordReader reader(file);
+        vector<string_view> fields;
+        size_t count = 0;
+        while (reader.next(fields)) count += fields.size();
+        return count;
+    }
+
+    static size_t countFieldsGetline(const string& filename) {
+        ifstream file(filename);
+        string line, field;
+        size_t count = 0;
+        while (getline(file, line)) {
+            if (line.empty()) continue;
+            stringstream ss(line);
+            while (getline(ss, field, '|')) count++;
+        }
+        return count;
+    }
+
+    void runSteps(const BenchmarkConfig& config, const string& program) {
+        vector<Student> students;
+        size_t n = config.students;
+
+        measure("generate_dataset", 0, [&] { return generate(config, students); });
+
+        measure("student_save", n, [&] { return StudentStore::compact(students); });
+        measure("student_load", n, [&] { return StudentStore::load().size() == n; });
+        size_t studentBytes = static_cast<size_t>(max<streamoff>(0, getFileSize(STUDENT_FILE)));
+        measure("parse_students_mmap", n, [&] { return countFieldsMapped(STUDENT_FILE) > 0; }, studentBytes);
+        measure("parse_students_getline", n, [&] { return countFieldsGetline(STUDENT_FILE) > 0; }, studentBytes);
+        measure("student_repository_build", n, [&] { return StudentRepository::count() == n; });
+
+        measure("attendance_convert", attendanceRecords, [&] {
+            return AttendanceStore::convertFromText(ATTENDANCE_FILE) ==
+                   static_cast<long>(attendanceRecords);
+        });
+        measure("attendance_load", attendanceRecords, [&] {
+            return AttendanceStore::getColumns().size() == attendanceRecords;
+        });
+        size_t attendanceBytes = static_cast<size_t>(max<streamoff>(0, getFileSize(ATTENDANCE_FILE)));
+        measure("parse_attendance_mmap", attendanceRecords, [&] { return countFieldsMapped(ATTENDANCE_FILE) > 0; }, attendanceBytes);
+        measure("parse_attendance_getline", attendanceRecords, [&] { return countFieldsGetline(ATTENDANCE_FILE) > 0; }, attendanceBytes);
+        {
+            // The same mapped parse with each delimiter scanning kernel the CPU supports
+            size_t expected = countFieldsMapped(ATTENDANCE_FILE);
+            for (DelimiterScanner::Kernel kernel : {DelimiterScanner::SCALAR, DelimiterScanner::SSE2, DelimiterScanner::AVX2}) {
+                DelimiterScanner::setKernel(kernel);
+                if (DelimiterScanner::kernel() != kernel) continue;
+                measure(string("parse_attendance_") + DelimiterScanner::kernelName(kernel), attendanceRecords,
+                        [&] { return countFieldsMapped(ATTENDANCE_FILE) == expected; }, attendanceBytes);
+            }
+            DelimiterScanner::setKernel(DelimiterScanner::AVX2);     // back to the best available
+        }
+        measure("attendance_index_build", attendanceRecords, [&] {
+            AttendanceIndex::sync();
+            return true;
+        });
+
+        measure("calculate_attendance_percentage", n * (1 + subjectNames.size()), [&] {
+            double sum = 0;
+            for (const auto& student : students) {
+                sum += Attendance::calculateAttendancePercentage(student.getRollNo());
+                for (const auto& subject : subjectNames) {
+                    sum += Attendance::calculateAttendancePercentage(student.getRollNo(), subject);
+                }
+            }
+            return sum > 0;
+        });
+        measure("attendance_totals_sweep", n, [&] {
+            size_t held = 0;
+            for (const auto& counter : AttendanceIndex::totalsFor(students)) held += counter.total;
+            return held == attendanceRecords;
+        });
+        for (BitCount::Kernel kernel : {BitCount::SCALAR, BitCount::POPCNT, BitCount::AVX2}) {
+            // Kernels this CPU lacks are skipped rather than measured twice under another name
+            BitCount::setKernel(kernel);
+            if (BitCount::kernel() != kernel) continue;
+            measure(string("class_totals_") + BitCount::kernelName(kernel), attendanceRecords * 10, [&] {
+                bool ok = true;
+                for (int i = 0; i < 10; i++) ok = ok && AttendanceIndex::classTotals().total == static_cast<int>(attendanceRecords);
+                return ok;
+            });
+        }
+        BitCount::setKernel(BitCount::AVX2);     // back to the best available
+        measure("get_available_dates", 100, [&] {
+            size_t total = 0;
+            for (int i = 0; i < 100; i++) total += Attendance::getAvailableDates().size();
+            return total > 0;
+        });
+        measure("get_subjects_for_student", n, [&] {
+            size_t total = 0;
+            for (const auto& student : students) total += Attendance::getSubjectsForStudent(student.getRollNo()).size();
+            return total > 0;
+        });
+
+        string firstRoll = students.empty() ? "" : students.front().getRollNo();
+        string month = daysToDate(firstDay).substr(0, 7);
+        string date = daysToDate(firstDay);
+
+        measure("report_full", n, [&] {
+            bool ok = ReportGenerator::generateAttendanceReportCSV(students, "full");
+            removeReport(ReportGenerator::getLastReportFile());
+            return ok;
+        });
+        measure("report_department", n, [&] {
+            bool ok = ReportGenerator::generateDepartmentReportCSV();
+            removeReport(ReportGenerator::getLastReportFile());
+            return ok;
+        });
+        measure("report_daily", n * subjectNames.size(), [&] {
+            bool ok = ReportGenerator::generateDailyAttendanceReportCSV(date);
+            removeReport(ReportGenerator::getLastReportFile());
+            return ok;
+        });
+        measure("report_daily_all", attendanceRecords, [&] {
+            bool ok = ReportGenerator::generateDailyAttendanceReportCSV("all");
+            removeReport(ReportGenerator::getLastReportFile());
+            return ok;
+        });
+        measure("report_bundle", attendanceRecords, [&] {
+            vector<string> files;
+            bool ok = ReportGenerator::generateReportBundle(students, files);
+            for (const auto& file : files) removeReport(file);
+            return ok;
+        });
+        measure("report_monthly", 1, [&] {
+            bool ok = ReportGenerator::generateMonthlyReportCSV(firstRoll, month);
+            removeReport(ReportGenerator::getLastReportFile());
+            return ok;
+        });
+        measure("report_monthly_all", n, [&] {
+            vector<string> rollNos;
+            rollNos.reserve(students.size());
+            for (const auto& student : students) rollNos.push_back(student.getRollNo());
+            string directory;
+            bool ok = ReportGenerator::generateMonthlyReportsCSV(rollNos, month, directory);
+            error_code ec;
+            if (!directory.empty()) filesystem::remove_all(directory, ec);
+            return ok;
+        });
+        measure("exam_index_build", examResults, [&] {
+            return ExamResultIndex::forStudent(firstRoll).size() == subjectNames.size();
+        });
+        measure("report_performance", 1, [&] {
+            bool ok = ReportGenerator::generateStudentPerformanceReport(firstRoll);
+            removeReport(ReportGenerator::getLastReportFile());
+            return ok;
+        });
+
+        // Thread scaling of the sharded comprehensive report
+        size_t poolThreads = WorkerPool::threadCount();
+        for (size_t threads : {1, 2, 4, 8}) {
+            WorkerPool::setThreadCount(threads);
+            measure("report_full_threads_" + to_string(threads), n, [&] {
+                bool ok = ReportGenerator::generateAttendanceReportCSV(students, "full");
+                removeReport(ReportGenerator::getLastReportFile());
+                return ok;
+            });
+        }
+        WorkerPool::setThreadCount(poolThreads);
+
+        // Resizing the pool between jobs must not let new workers replay the previous job
+        const size_t resizeRounds = 500, resizeTasks = 64;
+        measure("worker_pool_resize", resizeRounds * resizeTasks, [&] {
+            vector<atomic<int>> runs(resizeTasks);
+            bool ok = true;
+            for (size_t round = 0; round < resizeRounds && ok; round++) {
+                for (auto& count : runs) count = 0;
+                WorkerPool::setThreadCount(2 + round % 4);
+                WorkerPool::parallelFor(resizeTasks, [&](size_t task) { runs[task]++; });
+                for (auto& count : runs) ok = ok && count == 1;
+            }
+            WorkerPool::setThreadCount(poolThreads);
+            return ok;
+        });
+
+        measure("account_load", accounts, [&] { return StudentAccountStore::count() == accounts; });
+        measure("login_lookup", accounts, [&] {
+            bool ok = true;
+            StudentAccount account;
+            for (size_t i = 0; i < students.size(); i += 2) {
+                const string& rollNo = students[i].getRollNo();
+                ok = StudentAccountStore::authenticate("user" + rollNo, "pw" + rollNo, account) && ok;
+            }
+            return ok;
+        });
+
+        // Write paths: one more class day of roll calls, then durable single-student updates
+        string nextDate = daysToDate(firstDay + 7 * ((config.days + 4) / 5) + 7);
+        measure("attendance_append", n * subjectNames.size(), [&] {
+            for (const auto& subject : subjectNames) {
+                AttendanceBatch batch;
+                for (const auto& student : students) batch.add(student.getRollNo(), nextDate, "P", subject);
+                if (!batch.commit()) return false;
+            }
+            return true;
+        });
+        size_t updates = min<size_t>(n, 100);
+        measure("student_update_durable", updates, [&] {
+            for (size_t i = 0; i < updates; i++) {
+                Student student = students[i];
+                student.setPhone(to_string(8000000000ULL + i));
+                if (!StudentRepository::update(student)) return false;
+            }
+            return true;
+        });
+        measure("student_compact", StudentRepository::count(), [&] {
+            return StudentStore::compact(StudentRepository::all());
+        });
+
+        // Startup in a fresh process: first without a warm start file, then with the one it left
+        for (const char* kind : {"cold", "warm"}) {
+            error_code ec;
+            if (string(kind) == "cold") filesystem::remove(WARM_START_FILE, ec);
+
+            string output;
+            bool ok = runChild(program, "bench --startup-probe", output);
+            double ms = 0;
+            long peakKb = -1;
+            istringstream(output) >> ms >> peakKb;
+            steps.push_back({string("startup_") + kind, ms, n, peakKb, ok && ms > 0, 0});
+        }
+    }
+
+    string toJson(const BenchmarkConfig& config) const {
+        ostringstream json;
+        json << fixed << setprecision(3);
+        json << "{\n"
+             << "  \"version\": \"3.0\",\n"
+             << "  \"config\": {\"students\": " << config.students << ", \"classDays\": " << config.days
+             << ", \"subjects\": " << config.subjects << ", \"seed\": " << config.seed
+             << ", \"hardwareThreads\": " << thread::hardware_concurrency() << "},\n"
+             << "  \"dataset\": {\"attendanceRecords\": " << attendanceRecords << ", \"examResults\": " << examResults
+             << ", \"accounts\": " << accounts << "},\n"
+             << "  \"results\": [\n";
+        for (size_t i = 0; i < steps.size(); i++) {
+            const Step& step = steps[i];
+            json << "    {\"name\": " << jsonString(step.name) << ", \"ok\": " << (step.ok ? "true" : "false")
+                 << ", \"ms\": " << step.ms << ", \"ops\": " << step.ops;
+            if (step.ops > 0 && step.ms > 0) json << ", \"opsPerSec\": " << step.ops * 1000.0 / step.ms;
+            if (step.bytes > 0 && step.ms > 0) json << ", \"gbPerSec\": " << step.bytes / step.ms / 1e6;
+            json << ", \"peakKb\": " << step.peakKb << "}" << (i + 1 < steps.size() ? "," : "") << "\n";
+        }
+        json << "  ]\n}\n";
+        return json.str();
+    }
+
+    // Time to the first answers from every store, as a freshly started program sees it
+    static bool startupProbe(string& json) {
+        resetPeakMemory();
+        auto start = chrono::steady_clock::now();
+        WarmStart::load();
+        size_t students = StudentRepository::count();
+        AttendanceIndex::sync();
+        ExamResultIndex::forStudent("");
+        StudentAccountStore::count();
+        double ms = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+        long peakKb = peakMemoryKb();
+        WarmStart::save();
+
+        ostringstream out;
+        out << fixed << setprecision(3) << ms << " " << peakKb << "\n";
+        json = out.str();
+        return students > 0;
+    }
+
+public:
+    // Runs the suite and returns its JSON report; false if the data directory is unusable
+    static bool run(const BenchmarkConfig& config, const string& argv0, string& json) {
+        if (config.startupProbe) return startupProbe(json);
+
+        string program = programPath(argv0);
+        if (!prepareDirectory(config.directory)) return false;
+
+        if (!config.scales.empty()) {
+            // Each scale runs in its own process so that memory and caches start clean
+            json = "{\n\"runs\": [\n";
+            for (size_t i = 0; i < config.scales.size(); i++) {
+                string directory = (filesystem::path(config.directory) / to_string(config.scales[i])).string();
+                string output;
+                string arguments = "bench --students " + to_string(config.scales[i]) + " --days " +
+                                   to_string(config.days) + " --subjects " + to_string(config.subjects) +
+                                   " --seed " + to_string(config.seed) + " --dir \"" + directory + "\"";
+                if (!runChild(program, arguments, output)) return false;
+                json += output + (i + 1 < config.scales.size() ? ",\n" : "");
+            }
+            json += "]\n}\n";
+            return true;
+        }
+
+        error_code ec;
+        filesystem::path home = filesystem::current_path(ec);
+        filesystem::current_path(config.directory, ec);
+        if (ec) return false;
+
+        Benchmark benchmark;
+        benchmark.runSteps(config, program);
+        json = benchmark.toJson(config);
+
+        filesystem::current_path(home, ec);
+        return true;
+    }
+};
+
+// Command Line Class
+// Non-interactive subcommands for scripted runs (cron jobs, bulk loads). Nothing
+// here touches the console UI; results go to stdout/stderr and the exit code is
+// 0 on success, 1 when the operation fails and 2 for a malformed command line.
+class CommandLine {
+private:
+    static const int EXIT_OK = 0;
+    static const int EXIT_FAILED = 1;
+    static const int EXIT_USAGE = 2;
+
+    static int usage() {
+        cerr << "Usage:\n"
+             << "  student_system report full\n"
+             << "  student_system report department\n"
+             << "  student_system report bundle             (comprehensive + department + daily all)\n"
+             << "  student_system report daily YYYY-MM-DD|all\n"
+             << "  student_system report monthly ROLL YYYY-MM\n"
+             << "  student_system report monthly-all YYYY-MM (one CSV per student, in a new directory)\n"
+             << "  student_system report performance ROLL\n"
+             << "  student_system import students FILE      (roll,name,department,semester,email,phone)\n"
+             << "  student_system import attendance FILE    (roll,YYYY-MM-DD,P or A,subject)\n"
+             << "  student_system import exams FILE         (roll,semester,subject,marks,exam type)\n"
+             << "  student_system mark-attendance FILE      (roll|YYYY-MM-DD|P or A|subject)\n"
+             << "  student_system export attendance FILE\n"
+             << "  student_system bench [--students N] [--days N] [--subjects N] [--seed N]\n"
+             << "                       [--scales N,N,...] [--dir DIR] [--out FILE]\n";
+        return EXIT_USAGE;
+    }
+
+    static int reportResult(bool ok) {
+        if (!ok) {
+            cerr << "Error generating report\n";
+            return EXIT_FAILED;
+        }
+        cout << ReportGenerator::getLastReportFile() << "\n";
+        return EXIT_OK;
+    }
+
+    static int report(const vector<string>& args) {
+        if (args.size() < 2) return usage();
+        const string& type = args[1];
+
+        if (type == "full" && args.size() == 2) {
+            vector<Student> students = StudentRepository::all();
+            if (students.empty()) {
+                cerr << "No students found\n";
+                return EXIT_FAILED;
+            }
+            return reportResult(ReportGenerator::generateAttendanceReportCSV(students, "full"));
+        }
+        if (type == "bundle" && args.size() == 2) {
+            vector<Student> students = StudentRepository::all();
+            vector<string> files;
+            if (students.empty() || !ReportGenerator::generateReportBundle(students, files)) {
+                cerr << "Error generating report bundle\n";
+                return EXIT_FAILED;
+            }
+            for (const auto& file : files) cout << file << "\n";
+            return EXIT_OK;
+        }
+        if (type == "department" && args.size() == 2) {
+            vector<Student> students = StudentRepository::all();
+            if (students.empty()) {
+                cerr << "No students found\n";
+                return EXIT_FAILED;
+            }
+            return reportResult(ReportGenerator::generateDepartmentReportCSV());
+        }
+        if (type == "daily" && args.size() == 3) {
+            if (args[2] != "all" && dateToDays(args[2]) == INVALID_DAY) {
+                cerr << "Invalid date: " << args[2] << "\n";
+                return EXIT_USAGE;
+            }
+            return reportResult(ReportGenerator::generateDailyAttendanceReportCSV(args[2]));
+        }
+        if (type == "monthly" && args.size() == 4) {
+            int firstDay, lastDay;
+            if (!monthToDayRange(args[3], firstDay, lastDay)) {
+                cerr << "Invalid month: " << args[3] << "\n";
+                return EXIT_USAGE;
+            }
+            return reportResult(ReportGenerator::generateMonthlyReportCSV(args[2], args[3]));
+        }
+        if (type == "monthly-all" && args.size() == 3) {
+            vector<string> rollNos;
+            for (const auto& student : StudentRepository::all()) rollNos.push_back(student.getRollNo());
+            if (rollNos.empty()) {
+                cerr << "No students found\n";
+                return EXIT_FAILED;
+            }
+            int firstDay, lastDay;
+            if (!monthToDayRange(args[2], firstDay, lastDay)) {
+                cerr << "Invalid month: " << args[2] << "\n";
+                return EXIT_USAGE;
+            }
+            string directory;
+            return reportResult(ReportGenerator::generateMonthlyReportsCSV(rollNos, args[2], directory));
+        }
+        if (type == "performance" && args.size() == 3) {
+            return reportResult(ReportGenerator::generateStudentPerformanceReport(args[2]));
+        }
+        return usage();
+    }
+
+    static int importRecords(const string& kind, const string& filename) {
+        ImportSummary summary;
+        if (kind == "students") summary = BulkImporter::importStudents(filename);
+        else if (kind == "attendance") summary = BulkImporter::importAttendance(filename);
+        else if (kind == "exams") summary = BulkImporter::importExamResults(filename);
+        else return usage();
+
+        if (!summary.opened) {
+            cerr << "Cannot open " << filename << "\n";
+            return EXIT_FAILED;
+        }
+        if (!summary.committed) {
+            cerr << "Error saving imported records\n";
+            return EXIT_FAILED;
+        }
+
+        cout << summary.accepted << " " << kind << " records imported, " << summary.rejected << " rejected in "
+             << fixed << setprecision(3) << summary.seconds << "s\n";
+        if (!summary.errorReport.empty()) cerr << "Rejected rows listed in " << summary.errorReport << "\n";
+        return summary.rejected == 0 ? EXIT_OK : EXIT_FAILED;
+    }
+
+    static int markAttendance(const string& filename) {
+        MappedFile file(filename);
+        if (!file.isOpen()) {
+            cerr << "Cannot open " << filename << "\n";
+            return EXIT_FAILED;
+        }
+
+        // The whole file is one batch: either every record is stored or none is
+        RecordReader reader(file);
+        vector<string_view> fields;
+        AttendanceBatch batch;
+        size_t line = 0, rejected = 0;
+        while (reader.next(fields)) {
+            line++;
+            string rollNo(fieldAt(fields, 0));
+            string date(fieldAt(fields, 1));
+            string status(fieldAt(fields, 2));
+
+            const char* problem = nullptr;
+            if (!StudentRepository::exists(rollNo)) problem = "unknown roll number";
+            else if (dateToDays(date) == INVALID_DAY) problem = "invalid date";
+            else if (status != "P" && status != "A") problem = "status must be P or A";
+
+            if (problem) {
+                cerr << filename << ": record " << line << ": " << problem << "\n";
+                rejected++;
+                continue;
+            }
+            batch.add(rollNo, date, status, string(fieldAt(fields, 3)));
+        }
+
+        if (rejected > 0) {
+            cerr << "Nothing stored: " << rejected << " invalid records\n";
+            return EXIT_FAILED;
+        }
+        size_t stored = batch.size();
+        if (stored > 0 && !batch.commit()) {
+            cerr << "Error saving attendance\n";
+            return EXIT_FAILED;
+        }
+
+        cout << stored << " attendance records stored\n";
+        return EXIT_OK;
+    }
+
+    // Positive whole number option value; false if it is anything else
+    static bool parseCount(const string& text, size_t& value) {
+        if (!validateRollNo(text) || text.length() > 9) return false;
+        value = stoul(text);
+        return value > 0;
+    }
+
+    static int bench(const vector<string>& args, const string& program) {
+        BenchmarkConfig config;
+        string output;
+        for (size_t i = 1; i < args.size(); i++) {
+            const string& option = args[i];
+            if (option == "--startup-probe") {
+                config.startupProbe = true;
+                continue;
+            }
+            if (i + 1 >= args.size()) return usage();
+            const string& value = args[++i];
+
+            size_t number = 0;
+            if (option == "--dir") config.directory = value;
+            else if (option == "--out") output = value;
+            else if (option == "--scales") {
+                stringstream list(value);
+                string item;
+                while (getline(list, item, ',')) {
+                    if (!parseCount(item, number)) return usage();
+                    config.scales.push_back(number);
+                }
+            }
+            else if (!parseCount(value, number)) return usage();
+            else if (option == "--students") config.students = number;
+            else if (option == "--days") config.days = static_cast<int>(number);
+            else if (option == "--subjects") config.subjects = static_cast<int>(number);
+            else if (option == "--seed") config.seed = static_cast<unsigned>(number);
+            else return usage();
+        }
+
+        string json;
+        if (!Benchmark::run(config, program, json)) {
+            cerr << "Benchmark failed; " << config.directory << " must be new, empty or left by an earlier bench run\n";
+            return EXIT_FAILED;
+        }
+        if (output.empty()) {
+            cout << json;
+            return EXIT_OK;
+        }
+
+        ofstream file(output);
+        file << json;
+        if (!file) {
+            cerr << "Cannot write " << output << "\n";
+            return EXIT_FAILED;
+        }
+        cout << output << "\n";
+        return EXIT_OK;
+    }
+
+public:
+    static int run(int argc, char* argv[]) {
+        vector<string> args(argv + 1, argv + argc);
+        if (args.empty()) return usage();
+
+        const string& command = args[0];
+        if (command == "report") return report(args);
+        if (command == "bench") return bench(args, argv[0]);
+        if (command == "import" && args.size() == 3) return importRecords(args[1], args[2]);
+        if (command == "mark-attendance" && args.size() == 2) return markAttendance(args[1]);
+        if (command == "export" && args.size() == 3 && args[1] == "attendance") {
+            if (!AttendanceStore::exportText(args[2])) {
+                cerr << "Error exporting attendance\n";
+                return EXIT_FAILED;
+            }
+            cout << args[2] << "\n";
+            return EXIT_OK;
+        }
+        return usage();
     }
 };
 
@@ -2486,12 +8295,13 @@ private:
             }
             case 3: 
             case -1:
-                system("cls");
+                clearScreen();
                 drawBox(25, 10, 30, 5, "GOODBYE");
                 gotoxy(27, 12);
                 cout << "Thank you for using";
                 gotoxy(30, 13);
                 cout << "the system!";
+                WarmStart::save();
                 sleepMs(2000);
                 exit(0);
         }
@@ -2507,11 +8317,23 @@ public:
     }
 };
 
-int main() {
+int main(int argc, char* argv[]) {
+    if (argc > 1) {
+        // The benchmark brings its own data; it must not load or snapshot the real files
+        if (string(argv[1]) == "bench") return CommandLine::run(argc, argv);
+
+        // Commands use the snapshot but leave rewriting it to interactive sessions: a fresh
+        // snapshot brings every store up to date, which is O(history) for a one-record write
+        WarmStart::load();
+        return CommandLine::run(argc, argv);
+    }
+
+    WarmStart::load();
 #ifdef _WIN32
     system("title Student Attendance Management System");
     system("mode con: lines=30 cols=80");
 #endif
+    Screen::install();
     
     AttendanceSystem system;
     system.run();